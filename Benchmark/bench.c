@@ -0,0 +1,261 @@
+/***********************************************************
+* Filename: bench.c
+*
+* Overview:
+*   Microbenchmark driver for the containers in this repo (LLDeque,
+*	CLDeque and its deque template, Stack_from_Queues). For every
+*	size from 10 up to the given maximum (powers of ten) it runs each
+*	container's suite (benchLinkedList.c, benchCircularList.c,
+*	benchDequeTemplate.c, benchStack.c) in a forked child, so that
+*	no size inherits the memory of the sizes before it.
+*
+*	Every op is timed in batches of BENCH_BATCH calls (one call for
+*	O(n) ops); each batch gives one ns/op sample. A run keeps a
+*	uniform reservoir of BENCH_RESERVOIR samples, allocated and
+*	touched up front, so the harness's own memory does not grow
+*	with the number of samples. The output is one CSV row per
+*	(container, op, size):
+*		container,engine,op,size,ops,ns_per_op,mops_per_s,
+*		p50_ns,p99_ns,rss_growth_kb
+*	where ns_per_op is total time / ops, p50/p99 are percentiles
+*	of the kept samples and rss_growth_kb is the largest growth of
+*	the child's resident heap and stack over the baseline taken
+*	(benchBaseline) just before the container the op ran on was
+*	built. Each op is probed once it ends, for the first
+*	BENCH_RSS_BASELINES containers after the suite's benchStart
+*	calls; later rounds reuse the same memory.
+*
+* Usage:
+* 	1) make bench [LL_ENGINE=...] [CL_ENGINE=...] [STACK_ENGINE=...]
+*	2) ./bench [maxSize] [linkedList|circularList|dequeTemplate|stack]
+*	   maxSize defaults to 1000000 and may be up to 100000000.
+*	   'make compare_stacks' runs the stack suite for both stack
+*	   engines, one after the other.
+************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include "bench.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#define DEFAULT_MAX_SIZE 1000000L
+#define MAX_SIZE 100000000L
+
+static long baselineKb;		//resident set when the last baseline was taken
+static int baselines;		//baselines taken since the last benchStart
+
+/**
+	Returns a monotonic time in seconds.
+ */
+double benchNow()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+	Starts a new run with no samples.
+	param: 	run 		struct BenchRun ptr
+	param: 	container 	name of the container
+	param: 	engine 		name of its engine
+	param: 	op 			name of the operation
+	param: 	size 		number of elements in the container
+	post: 	run is ready for benchSample; probing starts over
+ */
+void benchStart(struct BenchRun* run, const char* container, const char* engine,
+	const char* op, long size)
+{
+	run->container = container;
+	run->engine = engine;
+	run->op = op;
+	run->size = size;
+	run->ops = 0;
+	run->seconds = 0;
+	run->sampleCount = 0;
+	run->seed = 1;
+	baselines = 0;
+	run->rssGrowthKb = 0;
+	//Touch the reservoir now so filling it does not show as growth.
+	run->samples = malloc(BENCH_RESERVOIR * sizeof(float));
+	assert(run->samples != NULL);
+	memset(run->samples, 0, BENCH_RESERVOIR * sizeof(float));
+}
+
+/**
+	Records ops calls that started at start and ended now. Once the
+	reservoir is full, the k'th sample replaces a random kept one
+	with probability BENCH_RESERVOIR / k, so the kept samples stay a
+	uniform pick of all of them.
+	param: 	run 	struct BenchRun ptr
+	param: 	start 	double, benchNow() before the calls
+	param: 	ops 	long, number of calls timed
+ */
+void benchSample(struct BenchRun* run, double start, long ops)
+{
+	double elapsed = benchNow() - start;
+	float sample = (float)(elapsed * 1e9 / ops);
+	long k = run->sampleCount++;
+	if (k < BENCH_RESERVOIR) {
+		run->samples[k] = sample;
+	}
+	else {
+		long j = (long)(((unsigned long)benchRand(&run->seed) << 16
+			^ benchRand(&run->seed)) % (unsigned long)(k + 1));
+		if (j < BENCH_RESERVOIR) {
+			run->samples[j] = sample;
+		}
+	}
+	run->ops += ops;
+	run->seconds += elapsed;
+}
+
+/**
+	Returns the child's current resident anonymous memory in KB
+	(resident minus file-backed pages, so code paged in on first use
+	does not count), or 0 if it can't be read (only Linux has
+	/proc/self/statm).
+ */
+static long residentKb()
+{
+	static int fd = -2;
+	if (fd == -2) {
+		fd = open("/proc/self/statm", O_RDONLY);
+	}
+	char text[128];
+	ssize_t got = fd >= 0 ? pread(fd, text, sizeof(text) - 1, 0) : -1;
+	if (got <= 0) return 0;
+	text[got] = '\0';
+	long size = 0, resident = 0, shared = 0;
+	if (sscanf(text, "%ld %ld %ld", &size, &resident, &shared) != 3) return 0;
+	return (resident - shared) * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/**
+	Takes the baseline that later probes measure growth from; call
+	it just before building a container. Freed heap memory is given
+	back first where the C library allows it (glibc), so memory of
+	a container destroyed earlier is not counted twice.
+ */
+void benchBaseline()
+{
+	if (++baselines > BENCH_RSS_BASELINES) return;
+#ifdef __GLIBC__
+	malloc_trim(0);
+#endif
+	baselineKb = residentKb();
+}
+
+/**
+	Records how far the resident set has grown over the current
+	baseline, if this suite still probes.
+	param: 	run 	struct BenchRun ptr
+	post: 	run->rssGrowthKb is the largest growth seen so far
+ */
+void benchProbe(struct BenchRun* run)
+{
+	if (baselines == 0 || baselines > BENCH_RSS_BASELINES) return;
+	long growth = residentKb() - baselineKb;
+	if (growth > run->rssGrowthKb) {
+		run->rssGrowthKb = growth;
+	}
+}
+
+static int compareFloats(const void* a, const void* b)
+{
+	float x = *(const float*)a;
+	float y = *(const float*)b;
+	return (x > y) - (x < y);
+}
+
+/**
+	Prints the run as one CSV row and frees its samples.
+	param: 	run 	struct BenchRun ptr
+ */
+void benchReport(struct BenchRun* run)
+{
+	double p50 = 0, p99 = 0;
+	long kept = run->sampleCount < BENCH_RESERVOIR ? run->sampleCount : BENCH_RESERVOIR;
+	if (kept > 0) {
+		qsort(run->samples, kept, sizeof(float), compareFloats);
+		p50 = run->samples[(kept - 1) * 50 / 100];
+		p99 = run->samples[(kept - 1) * 99 / 100];
+	}
+	double nsPerOp = run->ops > 0 ? run->seconds * 1e9 / run->ops : 0;
+	double mops = run->seconds > 0 ? run->ops / run->seconds / 1e6 : 0;
+	printf("%s,%s,%s,%ld,%ld,%.2f,%.3f,%.2f,%.2f,%ld\n",
+		run->container, run->engine, run->op, run->size, run->ops,
+		nsPerOp, mops, p50, p99, run->rssGrowthKb);
+	free(run->samples);
+	run->samples = NULL;
+}
+
+/**
+	Returns how many times to rebuild a container of size n so that
+	each op is timed at least BENCH_MIN_OPS times.
+ */
+long benchRounds(long n)
+{
+	long rounds = BENCH_MIN_OPS / n;
+	return rounds > 0 ? rounds : 1;
+}
+
+/**
+	Small LCG for picking values; the same seed gives the same values
+	for every engine.
+ */
+unsigned int benchRand(unsigned int* seed)
+{
+	*seed = *seed * 1103515245u + 12345u;
+	return *seed >> 1;
+}
+
+/**
+	Runs suite(n) in a child process and waits for it.
+ */
+static void runIsolated(void (*suite)(long), long n)
+{
+	fflush(stdout);
+	pid_t pid = fork();
+	assert(pid >= 0);
+	if (pid == 0) {
+		suite(n);
+		fflush(stdout);
+		_exit(0);
+	}
+	int status;
+	waitpid(pid, &status, 0);
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		fprintf(stderr, "bench: suite failed at size %ld\n", n);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	long maxSize = DEFAULT_MAX_SIZE;
+	const char* only = NULL;
+	if (argc > 1) maxSize = atol(argv[1]);
+	if (argc > 2) only = argv[2];
+	if (maxSize < 10 || maxSize > MAX_SIZE) {
+		fprintf(stderr, "usage: %s [maxSize 10..%ld] [linkedList|circularList|dequeTemplate|stack]\n",
+			argv[0], MAX_SIZE);
+		return 1;
+	}
+
+	printf("container,engine,op,size,ops,ns_per_op,mops_per_s,p50_ns,p99_ns,rss_growth_kb\n");
+	for (long n = 10; n <= maxSize; n *= 10) {
+		if (only == NULL || strcmp(only, "linkedList") == 0) runIsolated(benchLinkedList, n);
+		if (only == NULL || strcmp(only, "circularList") == 0) runIsolated(benchCircularList, n);
+		if (only == NULL || strcmp(only, "dequeTemplate") == 0) runIsolated(benchDequeTemplate, n);
+		if (only == NULL || strcmp(only, "stack") == 0) runIsolated(benchStack, n);
+	}
+	return 0;
+}
@@ -0,0 +1,69 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Timed batches per sample and minimum total ops per (op, size)
+#define BENCH_BATCH 64
+#define BENCH_MIN_OPS 1000000
+// Time budget for ops that are O(n) per call (scans, reverse, ...)
+#define BENCH_SCAN_SECONDS 0.25
+// Samples kept per run (a uniform reservoir of all of them)
+#define BENCH_RESERVOIR 4096
+// Baselines per suite whose containers are probed for RSS growth
+#define BENCH_RSS_BASELINES 32
+
+// Timing samples of one operation at one size
+struct BenchRun {
+	const char* container;
+	const char* engine;
+	const char* op;
+	long size;
+	long ops;
+	double seconds;
+	float* samples;			//ns per op of up to BENCH_RESERVOIR batches
+	long sampleCount;		//batches timed
+	unsigned int seed;		//for picking the batches kept
+	long rssGrowthKb;		//largest RSS growth seen after the op
+};
+
+double benchNow();
+void benchStart(struct BenchRun* run, const char* container, const char* engine,
+	const char* op, long size);
+void benchSample(struct BenchRun* run, double start, long ops);
+void benchBaseline();
+void benchProbe(struct BenchRun* run);
+void benchReport(struct BenchRun* run);
+long benchRounds(long n);
+unsigned int benchRand(unsigned int* seed);
+
+// Runs the statement(s) count times with i = 0..count-1, timing each
+// batch of batch iterations as one sample, and stops early once the
+// run has used budget seconds; then probes the RSS growth.
+#define BENCH_TIMED_UPTO(run, count, batch, budget, ...) \
+	do { \
+		for (long i_ = 0; i_ < (count) && (run)->seconds < (budget); ) { \
+			long end_ = i_ + (batch) < (count) ? i_ + (batch) : (count); \
+			double start_ = benchNow(); \
+			for (long i = i_; i < end_; i++) { __VA_ARGS__; } \
+			benchSample((run), start_, end_ - i_); \
+			i_ = end_; \
+		} \
+		benchProbe(run); \
+	} while (0)
+
+// All count iterations, in batches of BENCH_BATCH.
+#define BENCH_TIMED(run, count, ...) \
+	BENCH_TIMED_UPTO(run, count, BENCH_BATCH, 1e300, __VA_ARGS__)
+
+// One call per sample within BENCH_SCAN_SECONDS; for ops that are
+// O(n) per call.
+#define BENCH_TIMED_SCAN(run, count, ...) \
+	BENCH_TIMED_UPTO(run, count, 1, BENCH_SCAN_SECONDS, __VA_ARGS__)
+
+// Container suites; each runs every op at size n and reports it.
+
+void benchLinkedList(long n);
+void benchCircularList(long n);
+void benchStack(long n);
+void benchDequeTemplate(long n);
+
+#endif
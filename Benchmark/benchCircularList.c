@@ -0,0 +1,120 @@
+/***********************************************************
+* Filename: benchCircularList.c
+*
+* Overview:
+*   Benchmark suite for the CLDeque circular list (whichever engine
+*	the makefile's CL_ENGINE links in). Each round times the deque
+*	ops at both ends on a deque of n values, reverse, materialize
+*	(a reverse plus the O(n) materialize, one call per sample),
+*	split_concat (circularListSplitAt in the middle and the
+*	circularListConcat that joins the halves again, one pair per
+*	sample) and destroy, then circularListSort of n random values
+*	(one sample per sort), a cursor walk over the sorted deque
+*	(cursor_scan, one walk per sample, reported per value) and a
+*	text dump of it to /dev/null (dump, one dump per sample,
+*	reported per value). The deque is then saved to BENCH_SNAPSHOT
+*	and timed coming back, as a deque (load) and as a mapped view
+*	whose values are summed (view_scan), one file read per sample,
+*	reported per value.
+************************************************************/
+#include "bench.h"
+#include "circularList.h"
+#include <assert.h>
+#include <stdlib.h>
+
+// File the save/load rows write
+#ifndef BENCH_SNAPSHOT
+#define BENCH_SNAPSHOT "/tmp/bench.snapshot"
+#endif
+
+#ifndef BENCH_ENGINE
+#define BENCH_ENGINE "circularList"
+#endif
+
+enum {
+	ADD_FRONT, REMOVE_BACK, ADD_BACK, REMOVE_FRONT, REVERSE, MATERIALIZE, SPLIT_CONCAT, DESTROY, SORT, CURSOR_SCAN, DUMP, LOAD, VIEW_SCAN,
+	OPS
+};
+
+static const char* names[OPS] = {
+	"add_front", "remove_back", "add_back", "remove_front", "reverse", "materialize", "split_concat", "destroy", "sort", "cursor_scan", "dump", "load", "view_scan"
+};
+
+static volatile TYPE sink;
+
+void benchCircularList(long n)
+{
+	struct BenchRun runs[OPS];
+	for (int op = 0; op < OPS; op++) {
+		benchStart(&runs[op], "circularList", BENCH_ENGINE, names[op], n);
+	}
+	unsigned int seed = 1;
+	long rounds = benchRounds(n);
+	FILE* devNull = fopen("/dev/null", "w");
+	assert(devNull != NULL);
+	for (long r = 0; r < rounds; r++) {
+		benchBaseline();
+		struct CircularList* deque = circularListCreate();
+		BENCH_TIMED(&runs[ADD_FRONT], n, circularListAddFront(deque, (TYPE)i));
+		BENCH_TIMED(&runs[REMOVE_BACK], n, circularListRemoveBack(deque));
+		BENCH_TIMED(&runs[ADD_BACK], n, circularListAddBack(deque, (TYPE)i));
+		BENCH_TIMED(&runs[REVERSE], n, circularListReverse(deque));
+		BENCH_TIMED_SCAN(&runs[MATERIALIZE], n,
+			circularListReverse(deque); circularListMaterialize(deque));
+		BENCH_TIMED_SCAN(&runs[SPLIT_CONCAT], n,
+			struct CircularList* rest = circularListSplitAt(deque, (int)(n / 2));
+			circularListConcat(deque, rest);
+			circularListDestroy(rest));
+		BENCH_TIMED(&runs[REMOVE_FRONT], n, circularListRemoveFront(deque));
+		for (long i = 0; i < n; i++) {
+			circularListAddBack(deque, (TYPE)i);
+		}
+		double start = benchNow();
+		circularListDestroy(deque);
+		benchSample(&runs[DESTROY], start, 1);
+
+		benchBaseline();
+		deque = circularListCreate();
+		for (long i = 0; i < n; i++) {
+			circularListAddBack(deque, (TYPE)benchRand(&seed));
+		}
+		start = benchNow();
+		circularListSort(deque);
+		benchSample(&runs[SORT], start, 1);
+		benchProbe(&runs[SORT]);
+		struct CircularListCursor cursor;
+		start = benchNow();
+		for (circularListCursorFront(deque, &cursor); circularListCursorValid(&cursor);
+			circularListCursorNext(&cursor)) {
+			sink += circularListCursorGet(&cursor);
+		}
+		benchSample(&runs[CURSOR_SCAN], start, n);
+		benchProbe(&runs[CURSOR_SCAN]);
+		start = benchNow();
+		circularListDump(deque, devNull, CIRCULAR_LIST_DUMP_TEXT);
+		benchSample(&runs[DUMP], start, n);
+		benchProbe(&runs[DUMP]);
+		circularListSave(deque, BENCH_SNAPSHOT);
+		start = benchNow();
+		struct CircularList* loaded = circularListLoad(BENCH_SNAPSHOT);
+		benchSample(&runs[LOAD], start, n);
+		benchProbe(&runs[LOAD]);
+		assert(loaded != NULL);
+		circularListDestroy(loaded);
+		struct CircularListView view;
+		start = benchNow();
+		circularListViewOpen(&view, BENCH_SNAPSHOT);
+		for (int i = 0; i < view.size; i++) {
+			sink += view.values[i];
+		}
+		circularListViewClose(&view);
+		benchSample(&runs[VIEW_SCAN], start, n);
+		benchProbe(&runs[VIEW_SCAN]);
+		circularListDestroy(deque);
+	}
+	fclose(devNull);
+	remove(BENCH_SNAPSHOT);
+	for (int op = 0; op < OPS; op++) {
+		benchReport(&runs[op]);
+	}
+}
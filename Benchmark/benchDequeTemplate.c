@@ -0,0 +1,66 @@
+/***********************************************************
+* Filename: benchDequeTemplate.c
+*
+* Overview:
+*   Benchmark suite for the deque template (dequeTemplate.h),
+*	instantiated for double (the element type circularList.h is
+*	built with, so its rows line up with the circularList suite's)
+*	and for int in the same program. Each round times the deque ops
+*	at both ends on a deque of n values, contains with random values
+*	(half of them miss), and a sort of n random values (one sample
+*	per sort).
+************************************************************/
+#include "bench.h"
+#include "dequeTemplate.h"
+
+DEQUE_DEFINE(doubleDeque, double, DEQUE_LT, DEQUE_EQ, DEQUE_FORMAT_DOUBLE)
+DEQUE_DEFINE(intDeque, int, DEQUE_LT, DEQUE_EQ, DEQUE_FORMAT_INT)
+
+enum {
+	ADD_FRONT, REMOVE_BACK, ADD_BACK, REMOVE_FRONT, CONTAINS, SORT,
+	OPS
+};
+
+static const char* names[OPS] = {
+	"add_front", "remove_back", "add_back", "remove_front", "contains", "sort"
+};
+
+static volatile int sink;
+
+// Times every op on one instantiation; engine names the element type.
+#define BENCH_DEQUE(name, type, engine, n) \
+	do { \
+		struct BenchRun runs[OPS]; \
+		for (int op = 0; op < OPS; op++) { \
+			benchStart(&runs[op], "dequeTemplate", engine, names[op], n); \
+		} \
+		unsigned int seed = 1; \
+		long rounds = benchRounds(n); \
+		for (long r = 0; r < rounds; r++) { \
+			benchBaseline(); \
+			struct name* deque = name##Create(); \
+			BENCH_TIMED(&runs[ADD_FRONT], n, name##AddFront(deque, (type)i)); \
+			BENCH_TIMED(&runs[REMOVE_BACK], n, name##RemoveBack(deque)); \
+			BENCH_TIMED(&runs[ADD_BACK], n, name##AddBack(deque, (type)i)); \
+			BENCH_TIMED_SCAN(&runs[CONTAINS], n, \
+				sink += name##Contains(deque, (type)(benchRand(&seed) % (2 * n)))); \
+			BENCH_TIMED(&runs[REMOVE_FRONT], n, name##RemoveFront(deque)); \
+			for (long i = 0; i < n; i++) { \
+				name##AddBack(deque, (type)benchRand(&seed)); \
+			} \
+			double start = benchNow(); \
+			name##Sort(deque); \
+			benchSample(&runs[SORT], start, 1); \
+			benchProbe(&runs[SORT]); \
+			name##Destroy(deque); \
+		} \
+		for (int op = 0; op < OPS; op++) { \
+			benchReport(&runs[op]); \
+		} \
+	} while (0)
+
+void benchDequeTemplate(long n)
+{
+	BENCH_DEQUE(doubleDeque, double, "double", n);
+	BENCH_DEQUE(intDeque, int, "int", n);
+}
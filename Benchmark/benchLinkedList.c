@@ -0,0 +1,180 @@
+/***********************************************************
+* Filename: benchLinkedList.c
+*
+* Overview:
+*   Benchmark suite for the LLDeque linked list (whichever engine
+*	the makefile's LL_ENGINE links in). Each round builds a list
+*	of n values and times the deque ops (add/remove at both ends),
+*	the bag ops (contains and remove with random values, half of
+*	the contains misses) and destroy, then repeats the bag ops on
+*	a list made with linkedListCreateHashed and on one made with
+*	linkedListCreateSorted (adding random values), and times adds
+*	and counts on a linkedListCreateCounted bag holding only
+*	BENCH_DISTINCT distinct values. Last it times the bulk calls,
+*	AddBackN and RemoveFrontN, in runs of BENCH_BATCH values
+*	(reported per value, so they compare with add_back/remove_front),
+*	and linkedListSort of n random values (one sample per sort) and
+*	a cursor walk over the sorted list (cursor_scan, one walk per
+*	sample, reported per value), then a text dump of that list to
+*	/dev/null (dump, one dump per sample, reported per value). The
+*	list is then saved to BENCH_SNAPSHOT and timed coming back, as a
+*	list (load) and as a mapped view whose values are summed
+*	(view_scan), one file read per sample, reported per value.
+************************************************************/
+#include "bench.h"
+#include "linkedList.h"
+#include <assert.h>
+#include <stdlib.h>
+
+// Distinct values added to the counted bag
+#ifndef BENCH_DISTINCT
+#define BENCH_DISTINCT 64
+#endif
+
+// File the save/load rows write
+#ifndef BENCH_SNAPSHOT
+#define BENCH_SNAPSHOT "/tmp/bench.snapshot"
+#endif
+
+#ifndef BENCH_ENGINE
+#define BENCH_ENGINE "linkedList"
+#endif
+
+enum {
+	ADD_FRONT, REMOVE_BACK, ADD_BACK, REMOVE_FRONT,
+	CONTAINS, REMOVE, DESTROY,
+	ADD_HASHED, CONTAINS_HASHED, REMOVE_HASHED,
+	ADD_SORTED, CONTAINS_SORTED, REMOVE_SORTED,
+	ADD_COUNTED, COUNT_COUNTED,
+	ADD_BACK_N, REMOVE_FRONT_N, SORT, CURSOR_SCAN, DUMP, LOAD, VIEW_SCAN,
+	OPS
+};
+
+static const char* names[OPS] = {
+	"add_front", "remove_back", "add_back", "remove_front",
+	"contains", "remove", "destroy",
+	"add_hashed", "contains_hashed", "remove_hashed",
+	"add_sorted", "contains_sorted", "remove_sorted",
+	"add_counted", "count_counted",
+	"add_back_n", "remove_front_n", "sort", "cursor_scan", "dump", "load", "view_scan"
+};
+
+static volatile int sink;
+
+void benchLinkedList(long n)
+{
+	struct BenchRun runs[OPS];
+	for (int op = 0; op < OPS; op++) {
+		benchStart(&runs[op], "linkedList", BENCH_ENGINE, names[op], n);
+	}
+	unsigned int seed = 1;
+	TYPE batch[BENCH_BATCH];
+	for (int i = 0; i < BENCH_BATCH; i++) {
+		batch[i] = (TYPE)i;
+	}
+	long rounds = benchRounds(n);
+	FILE* devNull = fopen("/dev/null", "w");
+	assert(devNull != NULL);
+	for (long r = 0; r < rounds; r++) {
+		benchBaseline();
+		struct LinkedList* list = linkedListCreate();
+		BENCH_TIMED(&runs[ADD_FRONT], n, linkedListAddFront(list, (TYPE)i));
+		BENCH_TIMED(&runs[REMOVE_BACK], n, linkedListRemoveBack(list));
+		BENCH_TIMED(&runs[ADD_BACK], n, linkedListAddBack(list, (TYPE)i));
+		BENCH_TIMED(&runs[REMOVE_FRONT], n, linkedListRemoveFront(list));
+		for (long i = 0; i < n; i++) {
+			linkedListAdd(list, (TYPE)i);
+		}
+		BENCH_TIMED_SCAN(&runs[CONTAINS], n,
+			sink += linkedListContains(list, (TYPE)(benchRand(&seed) % (2 * n))));
+		BENCH_TIMED_SCAN(&runs[REMOVE], n,
+			linkedListRemove(list, (TYPE)(benchRand(&seed) % n)));
+		double start = benchNow();
+		linkedListDestroy(list);
+		benchSample(&runs[DESTROY], start, 1);
+
+		benchBaseline();
+		list = linkedListCreateHashed();
+		BENCH_TIMED(&runs[ADD_HASHED], n, linkedListAdd(list, (TYPE)i));
+		BENCH_TIMED_UPTO(&runs[CONTAINS_HASHED], n, BENCH_BATCH, BENCH_SCAN_SECONDS,
+			sink += linkedListContains(list, (TYPE)(benchRand(&seed) % (2 * n))));
+		BENCH_TIMED_UPTO(&runs[REMOVE_HASHED], n, BENCH_BATCH, BENCH_SCAN_SECONDS,
+			linkedListRemove(list, (TYPE)(benchRand(&seed) % n)));
+		linkedListDestroy(list);
+
+		benchBaseline();
+		list = linkedListCreateSorted();
+		BENCH_TIMED_UPTO(&runs[ADD_SORTED], n, BENCH_BATCH, BENCH_SCAN_SECONDS,
+			linkedListAdd(list, (TYPE)(benchRand(&seed) % n)));
+		BENCH_TIMED_UPTO(&runs[CONTAINS_SORTED], n, BENCH_BATCH, BENCH_SCAN_SECONDS,
+			sink += linkedListContains(list, (TYPE)(benchRand(&seed) % (2 * n))));
+		BENCH_TIMED_UPTO(&runs[REMOVE_SORTED], n, BENCH_BATCH, BENCH_SCAN_SECONDS,
+			if (!linkedListIsEmpty(list)) linkedListRemove(list, (TYPE)(benchRand(&seed) % n)));
+		linkedListDestroy(list);
+
+		benchBaseline();
+		list = linkedListCreateCounted();
+		BENCH_TIMED(&runs[ADD_COUNTED], n, linkedListAdd(list, (TYPE)(i % BENCH_DISTINCT)));
+		BENCH_TIMED_UPTO(&runs[COUNT_COUNTED], n, BENCH_BATCH, BENCH_SCAN_SECONDS,
+			sink += linkedListCount(list, (TYPE)(benchRand(&seed) % (2 * BENCH_DISTINCT))));
+		linkedListDestroy(list);
+
+		benchBaseline();
+		list = linkedListCreate();
+		for (long i = 0; i < n; i += BENCH_BATCH) {
+			int k = n - i < BENCH_BATCH ? (int)(n - i) : BENCH_BATCH;
+			start = benchNow();
+			linkedListAddBackN(list, batch, k);
+			benchSample(&runs[ADD_BACK_N], start, k);
+		}
+		benchProbe(&runs[ADD_BACK_N]);
+		for (long i = 0; i < n; i += BENCH_BATCH) {
+			int k = n - i < BENCH_BATCH ? (int)(n - i) : BENCH_BATCH;
+			start = benchNow();
+			linkedListRemoveFrontN(list, batch, k);
+			benchSample(&runs[REMOVE_FRONT_N], start, k);
+		}
+		benchProbe(&runs[REMOVE_FRONT_N]);
+		for (long i = 0; i < n; i++) {
+			linkedListAddBack(list, (TYPE)benchRand(&seed));
+		}
+		start = benchNow();
+		linkedListSort(list);
+		benchSample(&runs[SORT], start, 1);
+		benchProbe(&runs[SORT]);
+		struct LinkedListCursor cursor;
+		start = benchNow();
+		for (linkedListCursorFront(list, &cursor); linkedListCursorValid(&cursor);
+			linkedListCursorNext(&cursor)) {
+			sink += linkedListCursorGet(&cursor);
+		}
+		benchSample(&runs[CURSOR_SCAN], start, n);
+		benchProbe(&runs[CURSOR_SCAN]);
+		start = benchNow();
+		linkedListDump(list, devNull, LINKED_LIST_DUMP_TEXT);
+		benchSample(&runs[DUMP], start, n);
+		benchProbe(&runs[DUMP]);
+		linkedListSave(list, BENCH_SNAPSHOT);
+		start = benchNow();
+		struct LinkedList* loaded = linkedListLoad(BENCH_SNAPSHOT);
+		benchSample(&runs[LOAD], start, n);
+		benchProbe(&runs[LOAD]);
+		assert(loaded != NULL);
+		linkedListDestroy(loaded);
+		struct LinkedListView view;
+		start = benchNow();
+		linkedListViewOpen(&view, BENCH_SNAPSHOT);
+		for (int i = 0; i < view.size; i++) {
+			sink += view.values[i];
+		}
+		linkedListViewClose(&view);
+		benchSample(&runs[VIEW_SCAN], start, n);
+		benchProbe(&runs[VIEW_SCAN]);
+		linkedListDestroy(list);
+	}
+	fclose(devNull);
+	remove(BENCH_SNAPSHOT);
+	for (int op = 0; op < OPS; op++) {
+		benchReport(&runs[op]);
+	}
+}
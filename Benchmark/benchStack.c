@@ -0,0 +1,75 @@
+/***********************************************************
+* Filename: benchStack.c
+*
+* Overview:
+*   Benchmark suite for the stack (whichever engine the makefile's
+*	STACK_ENGINE links in: the two-queue stack or the array one).
+*	Each round times n single pushes, top, n pops, n pushes onto a
+*	stack made room for with listStackReserve (push_reserved), and
+*	one listStackPushN of n values (reported per value) followed by
+*	n pops.
+************************************************************/
+#include "bench.h"
+#include "stack_from_queue.h"
+#include <assert.h>
+#include <stdlib.h>
+
+#ifndef BENCH_ENGINE
+#define BENCH_ENGINE "stack_from_queue"
+#endif
+
+enum {
+	PUSH, TOP, POP, PUSH_RESERVED, PUSH_N, DESTROY,
+	OPS
+};
+
+static const char* names[OPS] = {
+	"push", "top", "pop", "push_reserved", "push_n", "destroy"
+};
+
+static volatile TYPE sink;
+
+void benchStack(long n)
+{
+	struct BenchRun runs[OPS];
+	for (int op = 0; op < OPS; op++) {
+		benchStart(&runs[op], "stack", BENCH_ENGINE, names[op], n);
+	}
+	TYPE* values = malloc(n * sizeof(TYPE));
+	assert(values != NULL);
+	for (long i = 0; i < n; i++) {
+		values[i] = (TYPE)i;
+	}
+	long rounds = benchRounds(n);
+	for (long r = 0; r < rounds; r++) {
+		benchBaseline();
+		struct Stack* stack = listStackCreate();
+		BENCH_TIMED(&runs[PUSH], n, listStackPush(stack, (TYPE)i));
+		BENCH_TIMED(&runs[TOP], n, sink = listStackTop(stack));
+		BENCH_TIMED(&runs[POP], n, sink = listStackPop(stack));
+		listStackDestroy(stack);
+
+		benchBaseline();
+		stack = listStackCreate();
+		listStackReserve(stack, (size_t)n);
+		BENCH_TIMED(&runs[PUSH_RESERVED], n, listStackPush(stack, (TYPE)i));
+		for (long i = 0; i < n; i++) {
+			listStackPop(stack);
+		}
+		double start = benchNow();
+		listStackPushN(stack, values, n);
+		benchSample(&runs[PUSH_N], start, n);
+		benchProbe(&runs[PUSH_N]);
+		for (long i = 0; i < n; i++) {
+			listStackPop(stack);
+		}
+		listStackPushN(stack, values, n);
+		start = benchNow();
+		listStackDestroy(stack);
+		benchSample(&runs[DESTROY], start, 1);
+	}
+	free(values);
+	for (int op = 0; op < OPS; op++) {
+		benchReport(&runs[op]);
+	}
+}
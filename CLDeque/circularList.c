@@ -15,10 +15,41 @@
 *		- printing the values of all the links
 *		- reversing the order of the links
 *
+*	Reversing is O(1): the deque only flips its reversed flag, and
+*	while it is set the front is the sentinel's prev link and the
+*	back is its next link, so every op reads the links from the
+*	other end. circularListMaterialize rewires the links into the
+*	logical order (O(n)) for when the physical order matters.
+*	circularListSort is a stable bottom-up merge sort by LT that
+*	relinks the existing links, so it allocates nothing.
+*
+*	circularListConcat, circularListSplitAt and circularListSplice
+*	move runs of links between deques by relinking their two ends,
+*	so no link is freed, allocated or copied; finding a position
+*	walks from the nearer end of the deque. A deque with a pending
+*	reverse is materialized first, so the runs are always physical.
+*
+*	circularListCreateFromArray carves all of its links out of one
+*	block and chains them in one pass. Each link points at the block
+*	it came from (NULL for a link malloc'd on its own), and the
+*	block counts its links that are still in use, so freeing one is
+*	O(1) wherever the splicing calls have moved it, and the block is
+*	freed with its last link.
+*
+*	A cursor holds a link (the sentinel once it is past either end)
+*	and moves in logical order. Every move prefetches the link after
+*	the new one, so its cache miss overlaps the caller's work on the
+*	current value.
+*
 *	Note that this implementation uses double links (links with
 *	next and prev pointers) and that given that it is a circular
 *	linked deque the last link points to the sentinel and the first
 *	link points to the Sentinel -- instead of null.
+*
+*	Built with -DCONTAINER_STATS, each deque also counts its
+*	operations, allocations, live bytes and the links materialize,
+*	sort and the splicing calls visit (see circularListGetStats);
+*	otherwise the STAT macro compiles away.
 ************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
@@ -29,18 +60,46 @@
 #define FORMAT_SPECIFIER "%g"
 #endif
 
+#include "circularListDump.h"
+
+#ifdef CONTAINER_STATS
+#define STAT(deque, field, n) ((deque)->stats.field += (n))
+#else
+#define STAT(deque, field, n) ((void)0)
+#endif
+
+// Hint that a link will be read soon; cursors issue it for the link
+// after the one they move to (NO_PREFETCH turns it off).
+#if defined(__GNUC__) && !defined(NO_PREFETCH)
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p) ((void)(p))
+#endif
+
 // Double link
 struct Link
 {
 	TYPE value;
 	struct Link * next;
 	struct Link * prev;
+	struct LinkBlock * block;	// block it was carved from, or NULL
+};
+
+// Links allocated at once by circularListCreateFromArray
+struct LinkBlock
+{
+	int live;		// links not freed yet
+	struct Link links[];
 };
 
 struct CircularList
 {
 	int size;
+	int reversed;	// 1 if the front is at sentinel->prev
 	struct Link* sentinel;
+#ifdef CONTAINER_STATS
+	struct CircularListStats stats;
+#endif
 };
 
 /**
@@ -61,7 +120,15 @@ static void init(struct CircularList* deque)
 	deque->sentinel->value = 0;
 	deque->sentinel->next = deque->sentinel;
 	deque->sentinel->prev = deque->sentinel;
+	deque->sentinel->block = NULL;
 	deque->size = 0;
+	deque->reversed = 0;
+#ifdef CONTAINER_STATS
+	struct CircularListStats zero = {0};
+	deque->stats = zero;
+	deque->stats.nodesAllocated = 1;
+	deque->stats.bytesLive = sizeof(struct CircularList) + sizeof(struct Link);
+#endif
 	/* FIXME: You will write this function */ //done?
 }
 
@@ -71,7 +138,7 @@ static void init(struct CircularList* deque)
 	pre: 	none
 	post: 	newLink is not null
 			newLink value init to value
-			newLink next and prev init to NULL
+			newLink next, prev and block init to NULL
  */
 static struct Link* createLink(TYPE value)
 {
@@ -80,10 +147,29 @@ static struct Link* createLink(TYPE value)
 	newLink->value = value;
 	newLink->next = NULL;
 	newLink->prev = NULL;
+	newLink->block = NULL;
 	return newLink;
 	/* FIXME: You will write this function */
 }
 
+/**
+	Frees a link, or if it was carved out of a block, frees the block
+	once none of its links is left.
+	param: 	link 	struct Link ptr
+	pre: 	link is not null and no longer in a deque
+	post: 	link (or its block, with its last link) is freed
+ */
+static void freeLink(struct Link* link)
+{
+	struct LinkBlock* block = link->block;
+	if (block == NULL) {
+		free(link);
+	}
+	else if (--block->live == 0) {
+		free(block);
+	}
+}
+
 /**
 	Adds a new link with the given value after the given link and
 	increments the deque's size.
@@ -100,35 +186,13 @@ static void addLinkAfter(struct CircularList* deque, struct Link* link, TYPE val
 	//struct Link* newLink = (struct Link*)malloc(sizeof(struct Link));
 	struct Link *newLink = createLink(value);
 	assert(newLink != 0);
-	if(deque->sentinel->next == deque->sentinel){
-		deque->sentinel->next = newLink;
-		deque->sentinel->prev = newLink;
-		newLink->next = deque->sentinel;
-		newLink->prev = deque->sentinel;
-	}
-	else if(link == deque->sentinel){
-		newLink->next = link->next;
-		link->next = newLink;
-		newLink->next->prev = newLink;
-		newLink->prev = link;
-	}
-	else if(link == deque->sentinel->prev){
-		newLink->prev = link;
-		newLink->next = deque->sentinel;
-		link->next = newLink;
-		deque->sentinel->prev = newLink;
-	}
-	else{
-		printf("Invalid link input\n");
-	}
-	/*
+	STAT(deque, nodesAllocated, 1);
+	STAT(deque, bytesLive, (long)sizeof(struct Link));
 	newLink->next = link->next;
 	newLink->prev = link;
 	newLink->next->prev = newLink;
 	link->next = newLink;
-	*/
 	deque->size += 1;
-	/* FIXME: You will write this function */ //done?
 }
 
 /**
@@ -145,12 +209,36 @@ static void removeLink(struct CircularList* deque, struct Link* link)
 	struct Link* temp = link;	 		//creates temp pointer to hold link memory address
 	link->prev->next = link->next; 		//takes next pointer from previous link and points it to link in front of link to be removed
 	link->next->prev = link->prev; 		//takes prev pointer from next link and points it to link behind link to be removed
-	free(temp); 						//frees temp pointer and link in list
+	freeLink(temp); 					//frees temp pointer and link in list
 	deque->size -= 1;					 //decrements linked list size
+	STAT(deque, nodesFreed, 1);
+	STAT(deque, bytesLive, -(long)sizeof(struct Link));
 
 	/* FIXME: You will write this function */ //done?
 }
 
+/**
+	Returns the link at the logical front of the deque.
+	param: 	deque 	struct CircularList ptr
+	pre: 	deque is not null
+	ret: 	sentinel's next link, or its prev link if reversed
+ */
+static struct Link* frontLink(struct CircularList* deque)
+{
+	return deque->reversed ? deque->sentinel->prev : deque->sentinel->next;
+}
+
+/**
+	Returns the link at the logical back of the deque.
+	param: 	deque 	struct CircularList ptr
+	pre: 	deque is not null
+	ret: 	sentinel's prev link, or its next link if reversed
+ */
+static struct Link* backLink(struct CircularList* deque)
+{
+	return deque->reversed ? deque->sentinel->next : deque->sentinel->prev;
+}
+
 /**
 	Allocates and initializes a deque.
 	pre: 	none
@@ -165,8 +253,48 @@ struct CircularList* circularListCreate()
 	return deque;
 }
 
+/**
+	Allocates a deque holding the given values, values[0] at the
+	front. The links are carved out of one block and chained to each
+	other in one pass: one allocation for the links however many
+	there are.
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	pre: 	values is not null unless n is 0, n >= 0
+	post: 	memory allocated for new struct CircularList ptr
+			deque holds the n values in order
+	return: deque
+ */
+struct CircularList* circularListCreateFromArray(const TYPE* values, int n)
+{
+	assert(n >= 0 && (values != NULL || n == 0));
+	struct CircularList* deque = circularListCreate();
+	if (n == 0) return deque;
+	struct LinkBlock* block = malloc(sizeof(struct LinkBlock) + n * sizeof(struct Link));
+	assert(block != 0);
+	block->live = n;
+	struct Link* prev = deque->sentinel;
+	for (int i = 0; i < n; i++) {
+		struct Link* link = &block->links[i];
+		link->value = values[i];
+		link->block = block;
+		link->prev = prev;
+		prev->next = link;
+		prev = link;
+	}
+	prev->next = deque->sentinel;
+	deque->sentinel->prev = prev;
+	deque->size = n;
+	STAT(deque, nodesAllocated, n);
+	STAT(deque, bytesLive, (long)(sizeof(struct LinkBlock) + n * sizeof(struct Link)));
+	return deque;
+}
+
 /**
 	Deallocates every link in the deque and frees the deque pointer.
+	The links are freed in one pass along the next pointers without
+	unlinking them first, since the whole ring goes away; a block of
+	links is freed with its last link.
 	pre: 	deque is not null
 	post: 	memory allocated to each link is freed
 			" " sentinel " "
@@ -175,18 +303,14 @@ struct CircularList* circularListCreate()
 void circularListDestroy(struct CircularList* deque)
 {
 	assert(deque != NULL);
-	while(deque->sentinel->next != deque->sentinel->prev){
-		struct Link* temp = deque->sentinel->next;
-		deque->sentinel->next = deque->sentinel->next->next;
-		free(temp);
-		deque->size -= 1;
+	struct Link* current = deque->sentinel->next;
+	while(current != deque->sentinel){
+		struct Link* temp = current;
+		current = current->next;
+		freeLink(temp);
 	}
-	deque->sentinel->next = deque->sentinel;
-	deque->sentinel->prev = deque->sentinel;
-	deque->size = 0;
 	free(deque->sentinel);
 	free(deque);
-	/* FIXME: You will write this function */ //done?
 }
 
 /**
@@ -195,12 +319,17 @@ void circularListDestroy(struct CircularList* deque)
 	param: 	value 	TYPE
 	pre: 	deque is not null
 	post: 	link is created w/ given value before current first link
-			(call to addLinkAfter)
+			(call to addLinkAfter; after the last physical link if
+			the deque is reversed)
  */
 void circularListAddFront(struct CircularList* deque, TYPE value)
 {
 	assert(deque != NULL);
-	addLinkAfter(deque, deque->sentinel, value);
+	STAT(deque, addFront, 1);
+	if (deque->reversed)
+		addLinkAfter(deque, deque->sentinel->prev, value);
+	else
+		addLinkAfter(deque, deque->sentinel, value);
 }
 
 /**
@@ -209,12 +338,17 @@ void circularListAddFront(struct CircularList* deque, TYPE value)
 	param: 	value 	TYPE
 	pre: 	deque is not null
 	post: 	link is created w/ given value after the current last link
-			(call to addLinkAfter)
+			(call to addLinkAfter; after the sentinel if the deque is
+			reversed)
  */
 void circularListAddBack(struct CircularList* deque, TYPE value)
 {
 	assert(deque != NULL);
-	addLinkAfter(deque, deque->sentinel->prev, value);
+	STAT(deque, addBack, 1);
+	if (deque->reversed)
+		addLinkAfter(deque, deque->sentinel, value);
+	else
+		addLinkAfter(deque, deque->sentinel->prev, value);
 }
 
 /**
@@ -227,7 +361,8 @@ void circularListAddBack(struct CircularList* deque, TYPE value)
  */
 TYPE circularListFront(struct CircularList* deque)
 {
-	return (deque->sentinel->next->value);
+	STAT(deque, front, 1);
+	return (frontLink(deque)->value);
 }
 
 /**
@@ -240,7 +375,8 @@ TYPE circularListFront(struct CircularList* deque)
  */
 TYPE circularListBack(struct CircularList* deque)
 {
-	return (deque->sentinel->prev->value);
+	STAT(deque, back, 1);
+	return (backLink(deque)->value);
 	/* FIXME: You will write this function */ //done?
 }
 
@@ -254,7 +390,8 @@ TYPE circularListBack(struct CircularList* deque)
 void circularListRemoveFront(struct CircularList* deque)
 {
 	assert(deque != NULL && deque->size != 0);
-	struct Link* temp = deque->sentinel->next;
+	STAT(deque, removeFront, 1);
+	struct Link* temp = frontLink(deque);
 	removeLink(deque, temp);
 	/* FIXME: You will write this function */ //needs another look?
 
@@ -270,7 +407,8 @@ void circularListRemoveFront(struct CircularList* deque)
 void circularListRemoveBack(struct CircularList* deque)
 {
 	assert(deque != NULL && deque->size != 0);
-	struct Link* temp = deque->sentinel->prev;
+	STAT(deque, removeBack, 1);
+	struct Link* temp = backLink(deque);
 	removeLink(deque, temp);
 	/* FIXME: You will write this function */ //done?
 
@@ -290,40 +428,118 @@ int circularListIsEmpty(struct CircularList* deque)
 	return 0;
 }
 
+#ifdef CONTAINER_STATS
 /**
-	Prints the values of the links in the deque from front to back.
+	Copies the deque's operation counters into stats.
 	param:	deque	struct CircularList ptr
-	pre:	deque is not null
-	post:	none
-	ret:	outputs to the console the values of the links from front
-			to back; if empty, prints msg that is empty
+	param:	stats	struct CircularListStats ptr
+	pre:	deque and stats are not null
+	post:	stats holds the counts since the deque was created
  */
-void circularListPrint(struct CircularList* deque)
+void circularListGetStats(struct CircularList* deque, struct CircularListStats* stats)
 {
-	struct Link* temp = deque->sentinel->next;
-	while(temp != deque->sentinel){
-		printf("%g\n", temp->value);
-		temp = temp->next;
+	assert(deque != NULL && stats != NULL);
+	*stats = deque->stats;
+}
+#endif
+
+/**
+	Adds every value of the deque to buffer, from front to back.
+	param:	deque	struct CircularList ptr
+	param:	buffer	struct DequeDump ptr
+	pre:	deque is not NULL, buffer was opened
+ */
+static void dumpValues(struct CircularList* deque, struct DequeDump* buffer)
+{
+	struct Link* link = frontLink(deque);
+	while (link != deque->sentinel) {
+		dumpValue(buffer, link->value);
+		link = deque->reversed ? link->prev : link->next;
 	}
 }
 
 /**
-	Reverses the deque in place without allocating any new memory.
-	The process works as follows: current starts pointing to sentinel;
-	tmp points to current's next, current's next points to current's prev,
-	current's prev is assigned to tmp and current points to current's next
-	(which points to current's prev), so you proceed stepping back through
-	the deque, assigning current's next to current's prev, until current
-	points to the sentinel then you know the each link has been looked at
-	and the link order reversed.
+	Writes the values in the deque from front to back to out.
+	param:	deque	struct CircularList ptr
+	param:	out		FILE ptr
+	param:	mode	CIRCULAR_LIST_DUMP_TEXT or CIRCULAR_LIST_DUMP_BINARY
+	pre:	deque and out are not NULL
+	ret:	0 if every write succeeded; otherwise, -1
+ */
+int circularListDump(struct CircularList* deque, FILE* out, int mode)
+{
+	assert(deque != NULL && out != NULL);
+	struct DequeDump buffer;
+	dequeDumpOpen(&buffer, out, -1, mode);
+	dumpValues(deque, &buffer);
+	return dequeDumpClose(&buffer);
+}
+
+/**
+	Writes the values in the deque from front to back to the file
+	descriptor fd.
+	param:	deque	struct CircularList ptr
+	param:	fd		int
+	param:	mode	CIRCULAR_LIST_DUMP_TEXT or CIRCULAR_LIST_DUMP_BINARY
+	pre:	deque is not NULL, fd is open for writing
+	ret:	0 if every write succeeded; otherwise, -1 (errno is set)
+ */
+int circularListDumpFd(struct CircularList* deque, int fd, int mode)
+{
+	assert(deque != NULL);
+	struct DequeDump buffer;
+	dequeDumpOpen(&buffer, NULL, fd, mode);
+	dumpValues(deque, &buffer);
+	return dequeDumpClose(&buffer);
+}
+
+/**
+	Prints the values in the deque from front to back, one per line.
+	param:	deque	struct CircularList ptr
+	pre:	deque is not NULL
+	ret:	outputs to the console the values from front to back
+ */
+void circularListPrint(struct CircularList* deque)
+{
+	circularListDump(deque, stdout, CIRCULAR_LIST_DUMP_TEXT);
+}
+
+/**
+	Reverses the order of the deque in O(1) by flipping its reversed
+	flag; no links are touched (see circularListMaterialize).
 	param: 	deque 	struct CircularList ptr
 	pre:	deque is not null
 	pre:	deque is not empty
-	post:	order of deque links is reversed
+	post:	front and back (and every op) now read the links from
+			the other end
  */
 void circularListReverse(struct CircularList* deque)
 {
 	assert(deque != NULL && deque->size != 0);
+	STAT(deque, reverse, 1);
+	deque->reversed = !deque->reversed;
+}
+
+/**
+	Rewires the links so their physical order matches the logical
+	order and clears the reversed flag. Does nothing unless the deque
+	is reversed. The process works as follows: current starts pointing
+	to sentinel; tmp points to current's next, current's next points
+	to current's prev, current's prev is assigned to tmp and current
+	points to current's next (which points to current's prev), so you
+	proceed stepping back through the deque, assigning current's next
+	to current's prev, until current points to the sentinel then you
+	know the each link has been looked at and the link order reversed.
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+	post:	sentinel next is the front link and the flag is cleared
+ */
+void circularListMaterialize(struct CircularList* deque)
+{
+	assert(deque != NULL);
+	if (!deque->reversed) return;
+	deque->reversed = 0;
+	STAT(deque, nodesTraversed, deque->size);
 	struct Link* current = deque->sentinel;
 	struct Link* tmp = current->next;
 
@@ -339,3 +555,356 @@ void circularListReverse(struct CircularList* deque)
 		current = current->next;
 	}
 }
+
+/**
+	Sorts a NULL-terminated chain of links (chained through next
+	only) by LT with a bottom-up merge sort: each pass merges
+	neighbouring sorted runs of insize links into runs of twice
+	that, until one pass does a single merge. Ties take the link
+	from the left run, so the sort is stable.
+	param: 	deque 	struct CircularList ptr (for stats)
+	param: 	head 	struct Link ptr, first link of the chain
+	pre: 	head is not null
+	post: 	the chain's links are relinked in LT order through next;
+			their prev pointers are not updated
+	ret: 	first link of the sorted chain
+ */
+static struct Link* mergeSortChain(struct CircularList* deque, struct Link* head)
+{
+	(void)deque;
+	for (int insize = 1; ; insize *= 2) {
+		struct Link* p = head;
+		struct Link* tail = NULL;
+		int merges = 0;
+		head = NULL;
+		while (p != NULL) {
+			//Right run starts insize links after p.
+			struct Link* q = p;
+			int psize = 0;
+			merges++;
+			while (psize < insize && q != NULL) {
+				psize++;
+				q = q->next;
+			}
+			int qsize = insize;
+			//Merge the two runs onto tail.
+			while (psize > 0 || (qsize > 0 && q != NULL)) {
+				struct Link* e;
+				if (psize == 0 || (qsize > 0 && q != NULL && LT(q->value, p->value))) {
+					e = q;
+					q = q->next;
+					qsize--;
+				}
+				else {
+					e = p;
+					p = p->next;
+					psize--;
+				}
+				STAT(deque, nodesTraversed, 1);
+				if (tail != NULL) tail->next = e;
+				else head = e;
+				tail = e;
+			}
+			p = q;
+		}
+		tail->next = NULL;
+		if (merges <= 1) return head;
+	}
+}
+
+/**
+	Sorts the deque by LT in O(n log n) without allocating: the links
+	are put in logical order (call to circularListMaterialize) and then
+	relinked in place (call to mergeSortChain). The sort is stable.
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+	post:	links are in LT order from front to back; equal values
+			keep their relative order; the reversed flag is cleared
+ */
+void circularListSort(struct CircularList* deque)
+{
+	assert(deque != NULL);
+	circularListMaterialize(deque);
+	if (deque->size < 2) return;
+	deque->sentinel->prev->next = NULL;
+	struct Link* link = mergeSortChain(deque, deque->sentinel->next);
+	//Restore the prev pointers and close the ring.
+	struct Link* prev = deque->sentinel;
+	prev->next = link;
+	while (link != NULL) {
+		link->prev = prev;
+		prev = link;
+		link = link->next;
+	}
+	prev->next = deque->sentinel;
+	deque->sentinel->prev = prev;
+}
+
+/**
+	Returns the link at the given logical position, walking from the
+	nearer end of the deque.
+	param: 	deque 	struct CircularList ptr
+	param: 	pos 	int
+	pre: 	deque is not null and not reversed, 0 <= pos <= size
+	ret: 	pos'th link from the front, or the sentinel if pos is size
+ */
+static struct Link* linkAt(struct CircularList* deque, int pos)
+{
+	struct Link* link;
+	if (pos <= deque->size / 2) {
+		link = deque->sentinel->next;
+		for (int i = 0; i < pos; i++) {
+			link = link->next;
+		}
+		STAT(deque, nodesTraversed, pos);
+	}
+	else {
+		link = deque->sentinel;
+		for (int i = deque->size; i > pos; i--) {
+			link = link->prev;
+		}
+		STAT(deque, nodesTraversed, deque->size - pos);
+	}
+	return link;
+}
+
+/**
+	Unlinks the run of links from first to last (following next) out
+	of src and links it into dst before the given link, adjusting both
+	sizes and live byte counts. Links carved from a block keep
+	pointing at it, wherever they move.
+	param: 	dst 	struct CircularList ptr
+	param: 	before 	struct Link ptr, in dst (the sentinel for the back)
+	param: 	src 	struct CircularList ptr
+	param: 	first 	struct Link ptr
+	param: 	last 	struct Link ptr
+	param: 	count 	int, number of links from first to last
+	pre: 	first..last is a run of count links in src, before is not in it
+	post: 	the run is in dst just before param before, in the same order
+ */
+static void moveLinks(struct CircularList* dst, struct Link* before,
+	struct CircularList* src, struct Link* first, struct Link* last, int count)
+{
+	//Close the gap in src.
+	first->prev->next = last->next;
+	last->next->prev = first->prev;
+	//Open one in dst.
+	first->prev = before->prev;
+	last->next = before;
+	before->prev->next = first;
+	before->prev = last;
+	src->size -= count;
+	dst->size += count;
+	STAT(src, bytesLive, -(long)count * (long)sizeof(struct Link));
+	STAT(dst, bytesLive, (long)count * (long)sizeof(struct Link));
+}
+
+/**
+	Moves every link of src to the back of dst in O(1), leaving src
+	empty (O(n) only if a deque has a pending reverse to materialize).
+	param: 	dst 	struct CircularList ptr
+	param: 	src 	struct CircularList ptr
+	pre:	dst and src are not null and not the same deque
+	post:	dst holds its values followed by src's; src is empty
+ */
+void circularListConcat(struct CircularList* dst, struct CircularList* src)
+{
+	assert(dst != NULL && src != NULL && dst != src);
+	circularListMaterialize(dst);
+	circularListMaterialize(src);
+	if (src->size == 0) return;
+	moveLinks(dst, dst->sentinel, src, src->sentinel->next, src->sentinel->prev, src->size);
+}
+
+/**
+	Cuts the deque in two after its first k values: the deque keeps
+	those and a new deque gets the rest, relinked in O(1) once the
+	k'th link is found (a walk of min(k, size - k) links).
+	param: 	deque 	struct CircularList ptr
+	param: 	k 		int
+	pre:	deque is not null, 0 <= k <= size
+	post:	deque holds its first k values
+	ret:	new deque holding the values from position k to the back
+ */
+struct CircularList* circularListSplitAt(struct CircularList* deque, int k)
+{
+	assert(deque != NULL && k >= 0 && k <= deque->size);
+	struct CircularList* rest = circularListCreate();
+	circularListMaterialize(deque);
+	if (k < deque->size) {
+		moveLinks(rest, rest->sentinel, deque, linkAt(deque, k), deque->sentinel->prev,
+			deque->size - k);
+	}
+	return rest;
+}
+
+/**
+	Moves count values of src, starting at position first, into dst
+	before position pos, by relinking the run's two ends. Finding the
+	run and the position walks at most half of each deque; the move
+	itself is O(1) whatever count is.
+	param: 	dst 	struct CircularList ptr
+	param: 	pos 	int, 0 (front) to dst size (back)
+	param: 	src 	struct CircularList ptr
+	param: 	first 	int
+	param: 	count 	int
+	pre:	dst and src are not null and not the same deque
+	pre:	0 <= pos <= dst size, first >= 0, count >= 0,
+			first + count <= src size
+	post:	the values are in dst from position pos on, in order,
+			and no longer in src
+ */
+void circularListSplice(struct CircularList* dst, int pos, struct CircularList* src,
+	int first, int count)
+{
+	assert(dst != NULL && src != NULL && dst != src);
+	assert(pos >= 0 && pos <= dst->size);
+	assert(first >= 0 && count >= 0 && first + count <= src->size);
+	if (count == 0) return;
+	circularListMaterialize(dst);
+	circularListMaterialize(src);
+	moveLinks(dst, linkAt(dst, pos), src, linkAt(src, first), linkAt(src, first + count - 1), count);
+}
+
+/**
+	Returns the link after the given one in logical order.
+	param: 	deque 	struct CircularList ptr
+	param: 	link 	struct Link ptr
+	pre: 	deque and link are not null
+	ret: 	link's next, or its prev if the deque is reversed
+ */
+static struct Link* logicalNext(struct CircularList* deque, struct Link* link)
+{
+	return deque->reversed ? link->prev : link->next;
+}
+
+/**
+	Returns the link before the given one in logical order.
+	param: 	deque 	struct CircularList ptr
+	param: 	link 	struct Link ptr
+	pre: 	deque and link are not null
+	ret: 	link's prev, or its next if the deque is reversed
+ */
+static struct Link* logicalPrev(struct CircularList* deque, struct Link* link)
+{
+	return deque->reversed ? link->next : link->prev;
+}
+
+/**
+	Puts the cursor on the front value of the deque (past the back if
+	the deque is empty).
+	param:	deque	struct CircularList ptr
+	param:	cursor	struct CircularListCursor ptr
+	pre:	deque and cursor are not null
+	post:	cursor is on the front link
+ */
+void circularListCursorFront(struct CircularList* deque, struct CircularListCursor* cursor)
+{
+	assert(deque != NULL && cursor != NULL);
+	struct Link* link = frontLink(deque);
+	PREFETCH(logicalNext(deque, link));
+	cursor->list = deque;
+	cursor->node = link;
+}
+
+/**
+	Puts the cursor on the back value of the deque (past the front if
+	the deque is empty).
+	param:	deque	struct CircularList ptr
+	param:	cursor	struct CircularListCursor ptr
+	pre:	deque and cursor are not null
+	post:	cursor is on the back link
+ */
+void circularListCursorBack(struct CircularList* deque, struct CircularListCursor* cursor)
+{
+	assert(deque != NULL && cursor != NULL);
+	struct Link* link = backLink(deque);
+	PREFETCH(logicalPrev(deque, link));
+	cursor->list = deque;
+	cursor->node = link;
+}
+
+/**
+	Returns 1 if the cursor is on a value and 0 if it is past either end.
+	param:	cursor	struct CircularListCursor ptr
+	pre:	cursor was set by circularListCursorFront/Back
+	ret:	1 if on a value; otherwise, 0
+ */
+int circularListCursorValid(struct CircularListCursor* cursor)
+{
+	assert(cursor != NULL);
+	return cursor->node != cursor->list->sentinel;
+}
+
+/**
+	Moves the cursor to the next value and prefetches the one after it.
+	param:	cursor	struct CircularListCursor ptr
+	pre:	cursor is on a value
+	post:	cursor is on the next link (past the back after the last)
+ */
+void circularListCursorNext(struct CircularListCursor* cursor)
+{
+	assert(circularListCursorValid(cursor));
+	struct Link* link = logicalNext(cursor->list, cursor->node);
+	PREFETCH(logicalNext(cursor->list, link));
+	cursor->node = link;
+}
+
+/**
+	Moves the cursor to the previous value and prefetches the one
+	before it.
+	param:	cursor	struct CircularListCursor ptr
+	pre:	cursor is on a value
+	post:	cursor is on the previous link (past the front after the first)
+ */
+void circularListCursorPrev(struct CircularListCursor* cursor)
+{
+	assert(circularListCursorValid(cursor));
+	struct Link* link = logicalPrev(cursor->list, cursor->node);
+	PREFETCH(logicalPrev(cursor->list, link));
+	cursor->node = link;
+}
+
+/**
+	Returns the value the cursor is on.
+	param:	cursor	struct CircularListCursor ptr
+	pre:	cursor is on a value
+	ret:	value of the cursor's link
+ */
+TYPE circularListCursorGet(struct CircularListCursor* cursor)
+{
+	assert(circularListCursorValid(cursor));
+	return ((struct Link*)cursor->node)->value;
+}
+
+/**
+	Removes the value the cursor is on and moves the cursor to the
+	next one. Other cursors on the removed link become invalid.
+	param:	cursor	struct CircularListCursor ptr
+	pre:	cursor is on a value
+	post:	the link is freed (call to removeLink)
+ */
+void circularListCursorErase(struct CircularListCursor* cursor)
+{
+	assert(circularListCursorValid(cursor));
+	struct Link* link = cursor->node;
+	cursor->node = logicalNext(cursor->list, link);
+	removeLink(cursor->list, link);
+}
+
+/**
+	Adds the value before the one the cursor is on, or at the back if
+	the cursor is past either end (the sentinel); the cursor stays
+	where it is.
+	param:	cursor	struct CircularListCursor ptr
+	param: 	value 	TYPE
+	pre:	cursor was set by circularListCursorFront/Back
+	post:	value is before the cursor's link (call to addLinkAfter)
+ */
+void circularListCursorInsert(struct CircularListCursor* cursor, TYPE value)
+{
+	assert(cursor != NULL);
+	struct Link* link = cursor->node;
+	//Physically, logical before is after link when reversed.
+	addLinkAfter(cursor->list, cursor->list->reversed ? link : link->prev, value);
+}
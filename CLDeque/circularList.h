@@ -1,6 +1,8 @@
 #ifndef CIRCULAR_LIST_H
 #define CIRCULAR_LIST_H
 
+#include <stdio.h>
+
 #ifndef TYPE
 #define TYPE double
 #endif
@@ -16,9 +18,40 @@
 struct CircularList;
 
 struct CircularList* circularListCreate();
+struct CircularList* circularListCreateFromArray(const TYPE* values, int n);
 void circularListDestroy(struct CircularList* list);
 void circularListPrint(struct CircularList* list);
 void circularListReverse(struct CircularList* list);
+void circularListMaterialize(struct CircularList* list);
+void circularListSort(struct CircularList* list);
+
+// Dump interface: writes every value from front to back through one
+// large buffer; returns 0, or -1 if a write failed. Text mode writes
+// each value with FORMAT_SPECIFIER and a newline, binary mode the raw
+// TYPE values.
+
+#define CIRCULAR_LIST_DUMP_TEXT 0
+#define CIRCULAR_LIST_DUMP_BINARY 1
+
+int circularListDump(struct CircularList* list, FILE* out, int mode);
+int circularListDumpFd(struct CircularList* list, int fd, int mode);
+
+// Snapshot interface (circularListSnapshot.c): a snapshot file holds a
+// header (TYPE's name and size, value count) and the packed values.
+// A view maps one read-only; values[0] is the front value.
+
+struct CircularListView
+{
+	const TYPE* values;
+	int size;
+	void* map;		//the whole mapped file
+	size_t bytes;	//" "
+};
+
+int circularListSave(struct CircularList* list, const char* path);
+struct CircularList* circularListLoad(const char* path);
+int circularListViewOpen(struct CircularListView* view, const char* path);
+void circularListViewClose(struct CircularListView* view);
 
 // Deque interface
 
@@ -30,4 +63,48 @@ void circularListRemoveFront(struct CircularList* list);
 void circularListRemoveBack(struct CircularList* list);
 int circularListIsEmpty(struct CircularList* list);
 
+// Splicing interface: moves values between two deques (relinking
+// links in circularList.c, copying values in the array engines)
+
+void circularListConcat(struct CircularList* dst, struct CircularList* src);
+struct CircularList* circularListSplitAt(struct CircularList* list, int k);
+void circularListSplice(struct CircularList* dst, int pos, struct CircularList* src,
+	int first, int count);
+
+// Cursor interface: a cursor is on one value of a deque, or past an
+// end once it moves off it. Changing the deque other than through
+// the cursor invalidates it.
+
+struct CircularListCursor
+{
+	struct CircularList* list;
+	void* node;	//engine-specific position
+	int index;	//" "
+};
+
+void circularListCursorFront(struct CircularList* list, struct CircularListCursor* cursor);
+void circularListCursorBack(struct CircularList* list, struct CircularListCursor* cursor);
+int circularListCursorValid(struct CircularListCursor* cursor);
+void circularListCursorNext(struct CircularListCursor* cursor);
+void circularListCursorPrev(struct CircularListCursor* cursor);
+TYPE circularListCursorGet(struct CircularListCursor* cursor);
+void circularListCursorErase(struct CircularListCursor* cursor);
+void circularListCursorInsert(struct CircularListCursor* cursor, TYPE value);
+
+// Operation counters (only when built with -DCONTAINER_STATS;
+// not available in the work-stealing engine)
+
+#ifdef CONTAINER_STATS
+struct CircularListStats
+{
+	long addFront, addBack, removeFront, removeBack, front, back, reverse;
+	long nodesAllocated;	// links (arrays in the ring engine) allocated
+	long nodesFreed;		// " " freed
+	long bytesLive;			// bytes currently malloc'd by the deque
+	long nodesTraversed;	// links (values) visited by materialize, sort and splices
+};
+
+void circularListGetStats(struct CircularList* list, struct CircularListStats* stats);
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+/***********************************************************
+* Filename: circularListDump.h
+*
+* Overview:
+*   Value writer the circularList engines share for
+*	circularListDump, circularListDumpFd and circularListPrint. The
+*	buffering (struct DequeDump, dequeDumpOpen/dequeDumpClose) is
+*	the one in dequeTemplate.h; this header adds dumpValue for this
+*	build's TYPE, so every engine and the template write the same
+*	bytes.
+*
+*	Text mode writes each value with FORMAT_SPECIFIER and a
+*	newline. With the default "%g", whole numbers under 1e6 (which
+*	"%g" prints as plain integers) are formatted by hand; other
+*	values and any other FORMAT_SPECIFIER go through snprintf.
+*	Binary mode copies the raw TYPE values, in host byte order.
+*
+*	Every function is static, so each engine gets its own copy.
+*	Include it after FORMAT_SPECIFIER is defined.
+************************************************************/
+#ifndef CIRCULAR_LIST_DUMP_H
+#define CIRCULAR_LIST_DUMP_H
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "dequeTemplate.h"
+
+/**
+	Formats value as text with FORMAT_SPECIFIER, the way snprintf
+	does.
+	param: 	out 	char ptr
+	param: 	room 	int, at least 20
+	param: 	value 	TYPE
+	ret: 	number of characters value needs
+ */
+static inline int formatValue(char* out, int room, TYPE value)
+{
+	if (strcmp(FORMAT_SPECIFIER, "%g") == 0 && value > -1e6 && value < 1e6
+		&& value == (long long)value && !(value == 0 && signbit(value))) {
+		return dequeFormatDecimal(out, (long long)value);
+	}
+	return snprintf(out, room, FORMAT_SPECIFIER, value);
+}
+
+DEQUE_DEFINE_DUMP_VALUE(dumpValue, TYPE, formatValue)
+
+#endif
@@ -0,0 +1,239 @@
+/***********************************************************
+* Filename: circularListIntrusive.c
+*
+* Overview:
+*   This program is an intrusive version of the circular doubly
+*	linked deque in circularList.c. The caller embeds an
+*	IntrusiveCircularLink in its own objects and passes the
+*	links in; the deque links them into a ring around its
+*	sentinel, so adding and removing never allocate:
+*
+*		struct Job { double due; struct IntrusiveCircularLink link; };
+*		intrusiveCircularListAddBack(deque, &job->link);
+*		...
+*		struct Job* j = CONTAINER_OF(
+*			intrusiveCircularListFront(deque), struct Job, link);
+*
+*	The sentinel is a member of the deque, so the deque is a
+*	single allocation, and destroying it does not touch the
+*	objects. As in circularList.c, reversing only flips the
+*	reversed flag; intrusiveCircularListMaterialize rewires the
+*	links into the logical order.
+*
+* Usage:
+* 	gcc -g -Wall -std=c99 -c circularListIntrusive.c
+************************************************************/
+#include <stdlib.h>
+#include <assert.h>
+#include "circularListIntrusive.h"
+
+// Circular double linked list of caller-owned links around a sentinel
+struct IntrusiveCircularList
+{
+	int size;
+	int reversed;	// 1 if the front is at sentinel.prev
+	struct IntrusiveCircularLink sentinel;
+};
+
+/**
+	Links the given link in after the given position in the ring.
+	param: 	deque 	struct IntrusiveCircularList ptr
+	param: 	pos 	struct IntrusiveCircularLink ptr
+	param: 	link 	struct IntrusiveCircularLink ptr
+	pre: 	pos is in the ring, link is not
+	post: 	link is pos's next, size is incremented by 1
+ */
+static void linkAfter(struct IntrusiveCircularList* deque, struct IntrusiveCircularLink* pos,
+	struct IntrusiveCircularLink* link)
+{
+	link->prev = pos;
+	link->next = pos->next;
+	pos->next->prev = link;
+	pos->next = link;
+	deque->size += 1;
+}
+
+/**
+	Allocates and initializes an empty deque.
+	pre: 	none
+	post: 	memory allocated for new struct IntrusiveCircularList ptr
+			sentinel next and prev point to the sentinel
+	return: deque
+ */
+struct IntrusiveCircularList* intrusiveCircularListCreate()
+{
+	struct IntrusiveCircularList* deque = malloc(sizeof(struct IntrusiveCircularList));
+	assert(deque != 0);
+	deque->sentinel.next = &deque->sentinel;
+	deque->sentinel.prev = &deque->sentinel;
+	deque->size = 0;
+	deque->reversed = 0;
+	return deque;
+}
+
+/**
+	Frees the deque. The objects whose links are still in it are not
+	touched; it is up to the caller to free them.
+	param: 	deque 	struct IntrusiveCircularList ptr
+	pre: 	deque is not null
+	post: 	memory allocated to the deque is freed
+ */
+void intrusiveCircularListDestroy(struct IntrusiveCircularList* deque)
+{
+	assert(deque != NULL);
+	free(deque);
+}
+
+/**
+	Adds the given link to the front of the deque.
+	param:	deque 	struct IntrusiveCircularList ptr
+	param: 	link 	struct IntrusiveCircularLink ptr
+	pre: 	deque and link are not null, link is not in a deque
+	post: 	link is the front link
+ */
+void intrusiveCircularListAddFront(struct IntrusiveCircularList* deque, struct IntrusiveCircularLink* link)
+{
+	assert(deque != NULL && link != NULL);
+	if (deque->reversed)
+		linkAfter(deque, deque->sentinel.prev, link);
+	else
+		linkAfter(deque, &deque->sentinel, link);
+}
+
+/**
+	Adds the given link to the back of the deque.
+	param:	deque 	struct IntrusiveCircularList ptr
+	param: 	link 	struct IntrusiveCircularLink ptr
+	pre: 	deque and link are not null, link is not in a deque
+	post: 	link is the back link
+ */
+void intrusiveCircularListAddBack(struct IntrusiveCircularList* deque, struct IntrusiveCircularLink* link)
+{
+	assert(deque != NULL && link != NULL);
+	if (deque->reversed)
+		linkAfter(deque, &deque->sentinel, link);
+	else
+		linkAfter(deque, deque->sentinel.prev, link);
+}
+
+/**
+	Returns the link at the front of the deque.
+	param: 	deque 	struct IntrusiveCircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	ret:	front link (use CONTAINER_OF to get its object)
+ */
+struct IntrusiveCircularLink* intrusiveCircularListFront(struct IntrusiveCircularList* deque)
+{
+	assert(deque != NULL && deque->size != 0);
+	return deque->reversed ? deque->sentinel.prev : deque->sentinel.next;
+}
+
+/**
+	Returns the link at the back of the deque.
+	param: 	deque 	struct IntrusiveCircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	ret:	back link (use CONTAINER_OF to get its object)
+ */
+struct IntrusiveCircularLink* intrusiveCircularListBack(struct IntrusiveCircularList* deque)
+{
+	assert(deque != NULL && deque->size != 0);
+	return deque->reversed ? deque->sentinel.next : deque->sentinel.prev;
+}
+
+/**
+	Unlinks the given link from the deque in O(1).
+	param: 	deque 	struct IntrusiveCircularList ptr
+	param: 	link 	struct IntrusiveCircularLink ptr
+	pre: 	deque and link are not null, link is in deque
+	post: 	link is no longer in the ring; its next and prev are null
+			deque size is decremented by 1
+ */
+void intrusiveCircularListRemove(struct IntrusiveCircularList* deque, struct IntrusiveCircularLink* link)
+{
+	assert(deque != NULL && link != NULL && deque->size != 0);
+	assert(link != &deque->sentinel);
+	link->prev->next = link->next;
+	link->next->prev = link->prev;
+	link->next = link->prev = NULL;
+	deque->size -= 1;
+}
+
+/**
+	Unlinks the front link of the deque and returns it.
+	param: 	deque 	struct IntrusiveCircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	post:	front link is removed (call to intrusiveCircularListRemove)
+	ret:	removed link
+ */
+struct IntrusiveCircularLink* intrusiveCircularListRemoveFront(struct IntrusiveCircularList* deque)
+{
+	struct IntrusiveCircularLink* link = intrusiveCircularListFront(deque);
+	intrusiveCircularListRemove(deque, link);
+	return link;
+}
+
+/**
+	Unlinks the back link of the deque and returns it.
+	param: 	deque 	struct IntrusiveCircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	post:	back link is removed (call to intrusiveCircularListRemove)
+	ret:	removed link
+ */
+struct IntrusiveCircularLink* intrusiveCircularListRemoveBack(struct IntrusiveCircularList* deque)
+{
+	struct IntrusiveCircularLink* link = intrusiveCircularListBack(deque);
+	intrusiveCircularListRemove(deque, link);
+	return link;
+}
+
+/**
+	Returns 1 if the deque is empty and 0 otherwise.
+	param:	deque	struct IntrusiveCircularList ptr
+	pre:	deque is not null
+	ret:	1 if its size is 0 (empty), otherwise 0 (not empty)
+ */
+int intrusiveCircularListIsEmpty(struct IntrusiveCircularList* deque)
+{
+	assert(deque != NULL);
+	return deque->size == 0;
+}
+
+/**
+	Reverses the order of the deque in O(1) by flipping its reversed
+	flag; no links are touched.
+	param: 	deque 	struct IntrusiveCircularList ptr
+	pre:	deque is not null
+	post:	front and back (and every op) now read the ring from the
+			other end
+ */
+void intrusiveCircularListReverse(struct IntrusiveCircularList* deque)
+{
+	assert(deque != NULL);
+	deque->reversed = !deque->reversed;
+}
+
+/**
+	Swaps every link's next and prev (sentinel included) so the
+	physical order matches the logical order, and clears the reversed
+	flag. Does nothing unless the deque is reversed.
+	param: 	deque 	struct IntrusiveCircularList ptr
+	pre:	deque is not null
+	post:	sentinel next is the front link and the flag is cleared
+ */
+void intrusiveCircularListMaterialize(struct IntrusiveCircularList* deque)
+{
+	assert(deque != NULL);
+	if (!deque->reversed) return;
+	deque->reversed = 0;
+	struct IntrusiveCircularLink* current = &deque->sentinel;
+	do {
+		struct IntrusiveCircularLink* tmp = current->next;
+		current->next = current->prev;
+		current->prev = tmp;
+		current = tmp;
+	} while (current != &deque->sentinel);
+}
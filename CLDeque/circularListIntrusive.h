@@ -0,0 +1,38 @@
+#ifndef CIRCULAR_LIST_INTRUSIVE_H
+#define CIRCULAR_LIST_INTRUSIVE_H
+
+#include <stddef.h>
+
+// Returns the object of the given type whose member is at ptr.
+#ifndef CONTAINER_OF
+#define CONTAINER_OF(ptr, type, member) \
+	((type*)((char*)(ptr) - offsetof(type, member)))
+#endif
+
+// Link header embedded in the caller's objects; an object can be in
+// one deque per IntrusiveCircularLink member.
+struct IntrusiveCircularLink
+{
+	struct IntrusiveCircularLink* next;
+	struct IntrusiveCircularLink* prev;
+};
+
+struct IntrusiveCircularList;
+
+struct IntrusiveCircularList* intrusiveCircularListCreate();
+void intrusiveCircularListDestroy(struct IntrusiveCircularList* list);
+void intrusiveCircularListReverse(struct IntrusiveCircularList* list);
+void intrusiveCircularListMaterialize(struct IntrusiveCircularList* list);
+
+// Deque interface; no call allocates or frees a link
+
+void intrusiveCircularListAddFront(struct IntrusiveCircularList* list, struct IntrusiveCircularLink* link);
+void intrusiveCircularListAddBack(struct IntrusiveCircularList* list, struct IntrusiveCircularLink* link);
+struct IntrusiveCircularLink* intrusiveCircularListFront(struct IntrusiveCircularList* list);
+struct IntrusiveCircularLink* intrusiveCircularListBack(struct IntrusiveCircularList* list);
+struct IntrusiveCircularLink* intrusiveCircularListRemoveFront(struct IntrusiveCircularList* list);
+struct IntrusiveCircularLink* intrusiveCircularListRemoveBack(struct IntrusiveCircularList* list);
+void intrusiveCircularListRemove(struct IntrusiveCircularList* list, struct IntrusiveCircularLink* link);
+int intrusiveCircularListIsEmpty(struct IntrusiveCircularList* list);
+
+#endif
@@ -0,0 +1,64 @@
+/***********************************************************
+* Filename: circularListIntrusiveMain.c
+*
+* Overview:
+*   Tests the intrusive circular list deque (circularListIntrusive.c)
+*	with jobs that embed their own link.
+*
+* Usage:
+* 	1) make -f makefilecirListDeque intrusive
+*	2) ./intrusive
+************************************************************/
+#include "circularListIntrusive.h"
+#include <stdio.h>
+
+struct Job {
+	double due;
+	struct IntrusiveCircularLink link;
+};
+
+void assertTrue(int pred, char* msg)
+{
+	printf("%s: ", msg);
+	if(pred)
+		printf("\tPASSED\n");
+	else
+		printf("\tFAILED\n");
+}
+
+double dueOf(struct IntrusiveCircularLink* link)
+{
+	return CONTAINER_OF(link, struct Job, link)->due;
+}
+
+int main()
+{
+	struct Job jobs[5];
+	for (int i = 0; i < 5; i++) {
+		jobs[i].due = i + 1;
+	}
+	struct IntrusiveCircularList* deque = intrusiveCircularListCreate();
+	assertTrue(intrusiveCircularListIsEmpty(deque), "new deque is empty");
+	for (int i = 0; i < 5; i++) {
+		intrusiveCircularListAddBack(deque, &jobs[i].link);
+	}
+	//Deque is now 1 2 3 4 5.
+	assertTrue(dueOf(intrusiveCircularListFront(deque)) == 1, "front due == 1");
+	assertTrue(dueOf(intrusiveCircularListBack(deque)) == 5, "back due == 5");
+	intrusiveCircularListReverse(deque);
+	assertTrue(dueOf(intrusiveCircularListFront(deque)) == 5, "reversed front due == 5");
+	assertTrue(dueOf(intrusiveCircularListRemoveBack(deque)) == 1, "reversed remove back due == 1");
+	intrusiveCircularListAddFront(deque, &jobs[0].link);
+	//Deque is now 1 5 4 3 2.
+	intrusiveCircularListMaterialize(deque);
+	intrusiveCircularListRemove(deque, &jobs[2].link);
+	int ok = 1;
+	double expected[] = {1, 5, 4, 2};
+	for (int i = 0; i < 4; i++) {
+		ok = ok && dueOf(intrusiveCircularListRemoveFront(deque)) == expected[i];
+	}
+	assertTrue(ok, "materialized dues are 1 5 4 2");
+	assertTrue(intrusiveCircularListIsEmpty(deque), "deque is empty");
+	intrusiveCircularListDestroy(deque);
+	return 0;
+}
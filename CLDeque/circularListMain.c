@@ -21,6 +21,23 @@ int main()
 	circularListReverse(deque);
 	circularListPrint(deque);
 	
+	circularListSort(deque);
+	circularListPrint(deque);
+	
+	struct CircularList* rest = circularListSplitAt(deque, 2);
+	circularListPrint(rest);
+	circularListConcat(rest, deque);
+	circularListPrint(rest);
+	circularListDestroy(rest);
+	
+	TYPE values[] = {7, 8, 9};
+	struct CircularList* built = circularListCreateFromArray(values, 3);
+	circularListSplice(deque, 0, built, 1, 2);
+	circularListDestroy(built);
+	circularListPrint(deque);
+	circularListRemoveFront(deque);
+	circularListPrint(deque);
+	
 	circularListDestroy(deque);
 	
 	return 0;
@@ -0,0 +1,76 @@
+/***********************************************************
+* Filename: circularListRing.c
+*
+* Overview:
+*   This program is a contiguous ring buffer implementation of
+*	the deque declared in circularList.h. It is a drop-in
+*	replacement for circularList.c (see makefilecirListDeque,
+*	ENGINE=circularListRing) and allows for the same behavior:
+*		- adding a new value to the front/back
+*		- getting the value at the front/back
+*		- removing the front/back value
+*		- checking if the deque is empty
+*		- printing all the values
+*		- reversing the order of the values
+*
+*	Values are stored in one array whose capacity is always a
+*	power of two, so positions wrap with a mask instead of a
+*	modulo. The front is at index start and the back at
+*	start + size - 1 (wrapped). When the array is full it doubles;
+*	if CIRCULAR_LIST_SHRINK is defined it also halves once the
+*	deque is down to a quarter of its capacity.
+*
+*	Reversing is O(1): it flips the reversed flag, and while the
+*	flag is set logical position pos maps to physical position
+*	size - 1 - pos, so the deque ops work on the other end of the
+*	array. circularListMaterialize swaps the values into the
+*	logical order.
+*
+*	circularListSort is a stable bottom-up merge sort over the
+*	values in place; each merge copies its shorter run into one
+*	scratch array of at most size / 2 values.
+*
+*	The splicing calls (circularListConcat, circularListSplitAt,
+*	circularListSplice) copy the values they move, since there are
+*	no links to relink; opening or closing a gap in the middle of a
+*	deque shifts whichever side of it is shorter.
+*
+*	A cursor holds a logical position, so stepping through the
+*	deque reads the array in order and needs no prefetch hints.
+*	Erasing or inserting at a cursor shifts the shorter side too.
+*
+*	With -DCONTAINER_STATS the node counters in CircularListStats
+*	count arrays rather than values.
+*
+*	The code is dequeTemplate.h's, instantiated once for TYPE with
+*	external linkage, so the template and this engine are one ring
+*	buffer: DEQUE_DEFINE_STRUCT writes struct CircularList and
+*	DEQUE_DEFINE_FUNCTIONS every circularList call but the snapshot
+*	ones (circularListSnapshot.c). CIRCULAR_LIST_MIN_CAPACITY and
+*	CIRCULAR_LIST_SHRINK set the template's DEQUE_MIN_CAPACITY and
+*	DEQUE_SHRINK.
+************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "circularList.h"
+
+#ifndef FORMAT_SPECIFIER
+#define FORMAT_SPECIFIER "%g"
+#endif
+
+// Capacity of a new deque; must be a power of two.
+#ifdef CIRCULAR_LIST_MIN_CAPACITY
+#define DEQUE_MIN_CAPACITY CIRCULAR_LIST_MIN_CAPACITY
+#endif
+
+#ifdef CIRCULAR_LIST_SHRINK
+#define DEQUE_SHRINK
+#endif
+
+#include "circularListDump.h"
+
+DEQUE_DEFINE_STRUCT(CircularList, TYPE)
+
+DEQUE_DEFINE_FUNCTIONS(CircularList, circularList, TYPE, LT, EQ, formatValue, )
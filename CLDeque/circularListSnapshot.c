@@ -0,0 +1,34 @@
+/***********************************************************
+* Filename: circularListSnapshot.c
+*
+* Overview:
+*   Snapshot files for CircularList, built on the public interface
+*	so every engine shares them (owner only in the work-stealing
+*	engine). A snapshot is a 32-byte header followed by the deque's
+*	values from front to back, packed, in host byte order:
+*		magic		8 bytes, "DEQSNAP1"
+*		type		12 bytes, TYPE as spelled in the build (NUL padded)
+*		valueBytes	uint32_t, sizeof(TYPE)
+*		count		uint64_t, number of values
+*	linkedListSnapshot.c writes the same format, so a snapshot of
+*	either deque loads into the other when TYPE matches.
+*
+*	circularListSave writes the values with circularListDump's
+*	binary mode. circularListViewOpen maps a snapshot read-only and
+*	checks its header; the values can then be read in place without
+*	building a deque. circularListLoad opens a view and builds a
+*	deque from its values in one call to circularListCreateFromArray,
+*	so every engine fills it in one block.
+*
+*	The functions are dequeTemplate.h's DEQUE_DEFINE_SNAPSHOT,
+*	instantiated for TYPE with external linkage, so deques the
+*	template writes save and load the same files.
+*
+* Usage:
+* 	gcc -g -Wall -std=c99 -c circularListSnapshot.c
+************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include "circularList.h"
+#include "dequeTemplate.h"
+
+DEQUE_DEFINE_SNAPSHOT(CircularList, circularList, TYPE, )
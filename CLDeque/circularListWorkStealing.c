@@ -0,0 +1,786 @@
+/***********************************************************
+* Filename: circularListWorkStealing.c
+*
+* Overview:
+*   This program is a Chase-Lev work-stealing implementation of
+*	the deque declared in circularList.h, for task schedulers:
+*	one owner thread pushes and pops tasks at the back while any
+*	number of thief threads take tasks from the front.
+*	It allows for the following behavior:
+*		- adding/removing at the back (owner only, lock-free)
+*		- stealing from the front (any thread, lock-free; see
+*		  circularListWorkStealing.h)
+*		- the rest of circularList.h, with the restrictions below
+*
+*	Values live in a growable circular array indexed by two
+*	counters that only ever increase: top (front) and bottom (one
+*	past the back). The owner moves bottom and thieves CAS top;
+*	the only race between them is for the last value, which both
+*	settle with a CAS on top. When the array is full the owner
+*	copies it into one twice the size. Thieves may still be
+*	reading the old array, so old arrays are kept until the deque
+*	is destroyed.
+*
+*	circularListAddFront, circularListReverse, circularListSort,
+*	circularListPrint, the splicing calls (which copy values) and
+*	the cursor calls move or read values thieves may be taking, so
+*	they may only be
+*	called by the owner while no thread is stealing (for example
+*	while seeding the deque). circularListRemoveFront is a steal
+*	and asserts that it succeeded.
+*
+* Usage:
+* 	gcc -g -Wall -std=c11 -c circularListWorkStealing.c
+************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include "circularListWorkStealing.h"
+
+#ifndef FORMAT_SPECIFIER
+#define FORMAT_SPECIFIER "%g"
+#endif
+
+#include "circularListDump.h"
+
+// Capacity of a new deque; must be a power of two.
+#ifndef CIRCULAR_LIST_MIN_CAPACITY
+#define CIRCULAR_LIST_MIN_CAPACITY 64
+#endif
+
+#define CACHE_LINE 64
+
+// Circular array of values; previous is the array it replaced.
+struct Array
+{
+	long capacity;
+	struct Array* previous;
+	_Atomic TYPE values[];
+};
+
+struct CircularList
+{
+	_Alignas(CACHE_LINE) atomic_long top;		//thieves
+	_Alignas(CACHE_LINE) atomic_long bottom;	//owner
+	_Atomic(struct Array*) array;
+};
+
+/**
+	Allocates an array with the given capacity.
+	param: 	capacity 	long, a power of two
+	param: 	previous 	struct Array ptr, array being replaced (or NULL)
+	ret: 	array (never NULL); values are uninitialized
+ */
+static struct Array* createArray(long capacity, struct Array* previous)
+{
+	struct Array* array = malloc(sizeof(struct Array) + capacity * sizeof(_Atomic TYPE));
+	assert(array != 0);
+	array->capacity = capacity;
+	array->previous = previous;
+	return array;
+}
+
+static TYPE getValue(struct Array* array, long i)
+{
+	return atomic_load_explicit(&array->values[i & (array->capacity - 1)], memory_order_relaxed);
+}
+
+static void putValue(struct Array* array, long i, TYPE value)
+{
+	atomic_store_explicit(&array->values[i & (array->capacity - 1)], value, memory_order_relaxed);
+}
+
+/**
+	Copies the values in [top, bottom) into an array twice the size
+	and publishes it. Owner only.
+	param: 	deque 	struct CircularList ptr
+	param: 	array 	struct Array ptr, the current array
+	param: 	top 	long
+	param: 	bottom 	long
+	ret: 	the new array
+ */
+static struct Array* grow(struct CircularList* deque, struct Array* array, long top, long bottom)
+{
+	struct Array* bigger = createArray(array->capacity * 2, array);
+	for (long i = top; i < bottom; i++) {
+		putValue(bigger, i, getValue(array, i));
+	}
+	atomic_store_explicit(&deque->array, bigger, memory_order_release);
+	return bigger;
+}
+
+/**
+	Allocates and initializes an empty deque.
+	pre: 	none
+	post: 	top and bottom are 0, array has CIRCULAR_LIST_MIN_CAPACITY slots
+	return: deque
+ */
+struct CircularList* circularListCreate()
+{
+	struct CircularList* deque = aligned_alloc(CACHE_LINE, sizeof(struct CircularList));
+	assert(deque != 0);
+	atomic_init(&deque->top, 0);
+	atomic_init(&deque->bottom, 0);
+	atomic_init(&deque->array, createArray(CIRCULAR_LIST_MIN_CAPACITY, NULL));
+	return deque;
+}
+
+/**
+	Allocates a deque holding the given values, values[0] at the
+	front. The array is sized for all of them once and, since no
+	thief can see the deque yet, they are copied in with one memcpy.
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	pre: 	values is not null unless n is 0, n >= 0
+	post: 	top is 0 and bottom is n
+	return: deque
+ */
+struct CircularList* circularListCreateFromArray(const TYPE* values, int n)
+{
+	assert(n >= 0 && (values != NULL || n == 0));
+	long capacity = CIRCULAR_LIST_MIN_CAPACITY;
+	while (capacity < n) {
+		capacity *= 2;
+	}
+	struct CircularList* deque = aligned_alloc(CACHE_LINE, sizeof(struct CircularList));
+	assert(deque != 0);
+	struct Array* array = createArray(capacity, NULL);
+	if (n > 0) {
+		memcpy((void*)array->values, values, n * sizeof(TYPE));
+	}
+	atomic_init(&deque->top, 0);
+	atomic_init(&deque->bottom, n);
+	atomic_init(&deque->array, array);
+	return deque;
+}
+
+/**
+	Frees the current array, every array it replaced, and the deque.
+	pre: 	deque is not null, no other thread is using it
+	post: 	memory allocated to the arrays and deque is freed
+ */
+void circularListDestroy(struct CircularList* deque)
+{
+	assert(deque != NULL);
+	struct Array* array = atomic_load(&deque->array);
+	while (array != NULL) {
+		struct Array* previous = array->previous;
+		free(array);
+		array = previous;
+	}
+	free(deque);
+}
+
+/**
+	Adds the given value to the back of the deque. Owner only.
+	param: 	deque 	struct CircularList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	value is visible to thieves after the current back value
+ */
+void circularListAddBack(struct CircularList* deque, TYPE value)
+{
+	assert(deque != NULL);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+	struct Array* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+	if (bottom - top > array->capacity - 1) {
+		array = grow(deque, array, top, bottom);
+	}
+	putValue(array, bottom, value);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+}
+
+/**
+	Removes the value at the back of the deque if there is one.
+	Owner only. If a thief is taking the same (last) value at the
+	same time, exactly one of them gets it.
+	param: 	deque 	struct CircularList ptr
+	param: 	value 	TYPE ptr, receives the removed value
+	pre:	deque and value are not null
+	ret:	1 if a value was removed, 0 if the deque was empty
+ */
+int circularListTryRemoveBack(struct CircularList* deque, TYPE* value)
+{
+	assert(deque != NULL && value != NULL);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+	struct Array* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+	atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	int removed = 1;
+	if (top <= bottom) {
+		*value = getValue(array, bottom);
+		if (top == bottom) {
+			//Last value: race thieves for it.
+			if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+					memory_order_seq_cst, memory_order_relaxed)) {
+				removed = 0;
+			}
+			atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+		}
+	}
+	else {
+		removed = 0;
+		atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+	}
+	return removed;
+}
+
+/**
+	Removes the value at the front of the deque if there is one.
+	Any thread may call this at any time.
+	param: 	deque 	struct CircularList ptr
+	param: 	value 	TYPE ptr, receives the stolen value
+	pre:	deque and value are not null
+	ret:	1 if a value was stolen, 0 if the deque was empty or
+			another thread took the front value first
+ */
+int circularListSteal(struct CircularList* deque, TYPE* value)
+{
+	assert(deque != NULL && value != NULL);
+	long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+	if (top >= bottom) return 0;
+	struct Array* array = atomic_load_explicit(&deque->array, memory_order_acquire);
+	TYPE stolen = getValue(array, top);
+	if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+			memory_order_seq_cst, memory_order_relaxed)) {
+		return 0;
+	}
+	*value = stolen;
+	return 1;
+}
+
+/**
+	Adds the given value to the front of the deque. Owner only, and
+	only while no thread is stealing.
+	param:	deque 	struct CircularList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not null
+	post: 	value is stored before the current front value
+ */
+void circularListAddFront(struct CircularList* deque, TYPE value)
+{
+	assert(deque != NULL);
+	long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	struct Array* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+	if (bottom - top > array->capacity - 1) {
+		array = grow(deque, array, top, bottom);
+	}
+	putValue(array, top - 1, value);
+	atomic_store_explicit(&deque->top, top - 1, memory_order_release);
+}
+
+/**
+	Returns the value at the front of the deque. If thieves are
+	active it may already have been stolen.
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	ret:	front value
+ */
+TYPE circularListFront(struct CircularList* deque)
+{
+	assert(deque != NULL && !circularListIsEmpty(deque));
+	long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+	return getValue(atomic_load_explicit(&deque->array, memory_order_acquire), top);
+}
+
+/**
+  	Returns the value at the back of the deque. Owner only; if
+	thieves are active the last value may already have been stolen.
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	ret:	back value
+ */
+TYPE circularListBack(struct CircularList* deque)
+{
+	assert(deque != NULL && !circularListIsEmpty(deque));
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	return getValue(atomic_load_explicit(&deque->array, memory_order_relaxed), bottom - 1);
+}
+
+/**
+	Removes the value at the front of the deque (a steal).
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty and no other thread takes its front value
+	post:	front value is removed
+ */
+void circularListRemoveFront(struct CircularList* deque)
+{
+	TYPE value;
+	int removed = circularListSteal(deque, &value);
+	assert(removed);
+	(void)removed;
+}
+
+/**
+	Removes the value at the back of the deque. Owner only.
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty and no other thread takes its last value
+	post:	back value is removed
+ */
+void circularListRemoveBack(struct CircularList* deque)
+{
+	TYPE value;
+	int removed = circularListTryRemoveBack(deque, &value);
+	assert(removed);
+	(void)removed;
+}
+
+/**
+	Returns 1 if the deque is empty and 0 otherwise (a snapshot if
+	other threads are using the deque).
+	param:	deque	struct CircularList ptr
+	pre:	deque is not null
+	ret:	1 if empty, otherwise 0
+ */
+int circularListIsEmpty(struct CircularList* deque)
+{
+	long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+	if (bottom <= top)
+		return 1;
+	return 0;
+}
+
+/**
+	Adds every value of the deque to buffer, from front to back.
+	param:	deque	struct CircularList ptr
+	param:	buffer	struct DequeDump ptr
+	pre:	deque is not NULL, buffer was opened
+ */
+static void dumpValues(struct CircularList* deque, struct DequeDump* buffer)
+{
+	long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	struct Array* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+	for (long i = top; i < bottom; i++) {
+		dumpValue(buffer, getValue(array, i));
+	}
+}
+
+/**
+	Writes the values in the deque from front to back to out. Owner
+	only, and only while no thread is stealing.
+	param:	deque	struct CircularList ptr
+	param:	out		FILE ptr
+	param:	mode	CIRCULAR_LIST_DUMP_TEXT or CIRCULAR_LIST_DUMP_BINARY
+	pre:	deque and out are not NULL
+	ret:	0 if every write succeeded; otherwise, -1
+ */
+int circularListDump(struct CircularList* deque, FILE* out, int mode)
+{
+	assert(deque != NULL && out != NULL);
+	struct DequeDump buffer;
+	dequeDumpOpen(&buffer, out, -1, mode);
+	dumpValues(deque, &buffer);
+	return dequeDumpClose(&buffer);
+}
+
+/**
+	Writes the values in the deque from front to back to the file
+	descriptor fd. Owner only, and only while no thread is stealing.
+	param:	deque	struct CircularList ptr
+	param:	fd		int
+	param:	mode	CIRCULAR_LIST_DUMP_TEXT or CIRCULAR_LIST_DUMP_BINARY
+	pre:	deque is not NULL, fd is open for writing
+	ret:	0 if every write succeeded; otherwise, -1 (errno is set)
+ */
+int circularListDumpFd(struct CircularList* deque, int fd, int mode)
+{
+	assert(deque != NULL);
+	struct DequeDump buffer;
+	dequeDumpOpen(&buffer, NULL, fd, mode);
+	dumpValues(deque, &buffer);
+	return dequeDumpClose(&buffer);
+}
+
+/**
+	Prints the values in the deque from front to back, one per line.
+	Owner only, and only while no thread is stealing.
+	param:	deque	struct CircularList ptr
+	pre:	deque is not NULL
+	ret:	outputs to the console the values from front to back
+ */
+void circularListPrint(struct CircularList* deque)
+{
+	circularListDump(deque, stdout, CIRCULAR_LIST_DUMP_TEXT);
+}
+
+/**
+	Reverses the deque in place by swapping values from both ends
+	towards the middle. Owner only, and only while no thread is stealing.
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+	pre:	deque is not empty
+	post:	order of deque values is reversed
+ */
+void circularListReverse(struct CircularList* deque)
+{
+	assert(deque != NULL && !circularListIsEmpty(deque));
+	long i = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	long j = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+	struct Array* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+	while (i < j) {
+		TYPE tmp = getValue(array, i);
+		putValue(array, i, getValue(array, j));
+		putValue(array, j, tmp);
+		i++;
+		j--;
+	}
+}
+
+/**
+	Does nothing: circularListReverse already moves the values here,
+	since thieves always take the physical top and cannot honor a
+	reversed flag.
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+ */
+void circularListMaterialize(struct CircularList* deque)
+{
+	assert(deque != NULL);
+}
+
+/**
+	Sorts the deque by LT in O(n log n) with a stable bottom-up merge
+	sort over the values in place, as in circularListRing.c: each merge
+	copies its shorter run into one scratch array of size / 2 values
+	and merges it back (ties take the left run). Owner only, and only
+	while no thread is stealing.
+	param: 	deque 	struct CircularList ptr
+	pre:	deque is not null
+	post:	values are in LT order from top to bottom; equal values
+			keep their relative order
+ */
+void circularListSort(struct CircularList* deque)
+{
+	assert(deque != NULL);
+	long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	long size = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - top;
+	struct Array* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+	if (size < 2) return;
+	TYPE* scratch = malloc((size / 2) * sizeof(TYPE));
+	assert(scratch != 0);
+	for (long width = 1; width < size; width *= 2) {
+		for (long lo = top; lo + width < top + size; lo += 2 * width) {
+			long mid = lo + width;
+			long hi = mid + width < top + size ? mid + width : top + size;
+			if (width <= hi - mid) {
+				for (long k = 0; k < width; k++) {
+					scratch[k] = getValue(array, lo + k);
+				}
+				long a = 0, b = mid, out = lo;
+				while (a < width) {
+					if (b < hi && LT(getValue(array, b), scratch[a]))
+						putValue(array, out++, getValue(array, b++));
+					else
+						putValue(array, out++, scratch[a++]);
+				}
+			}
+			else {
+				for (long k = 0; k < hi - mid; k++) {
+					scratch[k] = getValue(array, mid + k);
+				}
+				long a = mid, b = hi - mid, out = hi;
+				while (b > 0) {
+					if (a > lo && LT(scratch[b - 1], getValue(array, a - 1)))
+						putValue(array, --out, getValue(array, --a));
+					else
+						putValue(array, --out, scratch[--b]);
+				}
+			}
+		}
+	}
+	free(scratch);
+}
+
+/**
+	Moves the values at indices [from, from + n) to [to, to + n); the
+	ranges may overlap.
+	param: 	array 	struct Array ptr
+	param: 	to 		long
+	param: 	from 	long
+	param: 	n 		long
+	pre: 	both ranges fit in the array's capacity
+ */
+static void moveValues(struct Array* array, long to, long from, long n)
+{
+	if (to < from) {
+		for (long i = 0; i < n; i++) {
+			putValue(array, to + i, getValue(array, from + i));
+		}
+	}
+	else {
+		for (long i = n - 1; i >= 0; i--) {
+			putValue(array, to + i, getValue(array, from + i));
+		}
+	}
+}
+
+/**
+	Appends a copy of every value of src to the back of dst and leaves
+	src empty. Owner only (of both), and only while no thread is stealing.
+	param: 	dst 	struct CircularList ptr
+	param: 	src 	struct CircularList ptr
+	pre:	dst and src are not null and not the same deque
+	post:	dst holds its values followed by src's; src is empty
+ */
+void circularListConcat(struct CircularList* dst, struct CircularList* src)
+{
+	assert(dst != NULL && src != NULL && dst != src);
+	long dstSize = atomic_load_explicit(&dst->bottom, memory_order_relaxed)
+		- atomic_load_explicit(&dst->top, memory_order_relaxed);
+	long srcSize = atomic_load_explicit(&src->bottom, memory_order_relaxed)
+		- atomic_load_explicit(&src->top, memory_order_relaxed);
+	circularListSplice(dst, (int)dstSize, src, 0, (int)srcSize);
+}
+
+/**
+	Cuts the deque in two after its first k values: the deque keeps
+	those and a new deque gets a copy of the rest. Owner only, and only
+	while no thread is stealing.
+	param: 	deque 	struct CircularList ptr
+	param: 	k 		int
+	pre:	deque is not null, 0 <= k <= size
+	post:	deque holds its first k values
+	ret:	new deque holding the values from position k to the back
+ */
+struct CircularList* circularListSplitAt(struct CircularList* deque, int k)
+{
+	assert(deque != NULL);
+	long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	assert(k >= 0 && k <= bottom - top);
+	struct CircularList* rest = circularListCreate();
+	circularListSplice(rest, 0, deque, k, (int)(bottom - top - k));
+	return rest;
+}
+
+/**
+	Moves count values of src, starting at position first (0 is the
+	top), into dst before position pos, copying them. The gap opened
+	in dst and the one closed in src each shift the shorter side of
+	it. Owner only (of both), and only while no thread is stealing.
+	param: 	dst 	struct CircularList ptr
+	param: 	pos 	int, 0 (front) to dst size (back)
+	param: 	src 	struct CircularList ptr
+	param: 	first 	int
+	param: 	count 	int
+	pre:	dst and src are not null and not the same deque
+	pre:	0 <= pos <= dst size, first >= 0, count >= 0,
+			first + count <= src size
+	post:	the values are in dst from position pos on, in order,
+			and no longer in src
+ */
+void circularListSplice(struct CircularList* dst, int pos, struct CircularList* src,
+	int first, int count)
+{
+	assert(dst != NULL && src != NULL && dst != src);
+	long top = atomic_load_explicit(&dst->top, memory_order_relaxed);
+	long bottom = atomic_load_explicit(&dst->bottom, memory_order_relaxed);
+	struct Array* array = atomic_load_explicit(&dst->array, memory_order_relaxed);
+	long srcTop = atomic_load_explicit(&src->top, memory_order_relaxed);
+	long srcBottom = atomic_load_explicit(&src->bottom, memory_order_relaxed);
+	struct Array* srcArray = atomic_load_explicit(&src->array, memory_order_relaxed);
+	assert(pos >= 0 && pos <= bottom - top);
+	assert(first >= 0 && count >= 0 && first + count <= srcBottom - srcTop);
+	if (count == 0) return;
+	while (bottom - top + count > array->capacity) {
+		array = grow(dst, array, top, bottom);
+	}
+	//Open the gap at top + pos.
+	if (pos < bottom - top - pos) {
+		moveValues(array, top - count, top, pos);
+		top -= count;
+	}
+	else {
+		moveValues(array, top + pos + count, top + pos, bottom - top - pos);
+		bottom += count;
+	}
+	for (long i = 0; i < count; i++) {
+		putValue(array, top + pos + i, getValue(srcArray, srcTop + first + i));
+	}
+	atomic_store_explicit(&dst->top, top, memory_order_release);
+	atomic_store_explicit(&dst->bottom, bottom, memory_order_release);
+	//Close the gap in src.
+	long after = srcBottom - srcTop - first - count;
+	if (first < after) {
+		moveValues(srcArray, srcTop + count, srcTop, first);
+		atomic_store_explicit(&src->top, srcTop + count, memory_order_release);
+	}
+	else {
+		moveValues(srcArray, srcTop + first, srcTop + first + count, after);
+		atomic_store_explicit(&src->bottom, srcBottom - count, memory_order_release);
+	}
+}
+
+////////////////CURSOR//////////////CURSOR////////CURSOR/////////////
+//Cursor positions count from top. Owner only, and only while no
+//thread is stealing.
+
+/**
+	Returns the number of values in the deque, as the owner sees it.
+	param: 	deque 	struct CircularList ptr
+	pre: 	deque is not null
+	ret: 	bottom - top
+ */
+static int ownerSize(struct CircularList* deque)
+{
+	return (int)(atomic_load_explicit(&deque->bottom, memory_order_relaxed)
+		- atomic_load_explicit(&deque->top, memory_order_relaxed));
+}
+
+/**
+	Puts the cursor on the front value of the deque (past the back if
+	the deque is empty).
+	param:	deque	struct CircularList ptr
+	param:	cursor	struct CircularListCursor ptr
+	pre:	deque and cursor are not null
+	post:	cursor index is 0
+ */
+void circularListCursorFront(struct CircularList* deque, struct CircularListCursor* cursor)
+{
+	assert(deque != NULL && cursor != NULL);
+	cursor->list = deque;
+	cursor->node = NULL;
+	cursor->index = 0;
+}
+
+/**
+	Puts the cursor on the back value of the deque (past the front if
+	the deque is empty).
+	param:	deque	struct CircularList ptr
+	param:	cursor	struct CircularListCursor ptr
+	pre:	deque and cursor are not null
+	post:	cursor index is size - 1
+ */
+void circularListCursorBack(struct CircularList* deque, struct CircularListCursor* cursor)
+{
+	assert(deque != NULL && cursor != NULL);
+	cursor->list = deque;
+	cursor->node = NULL;
+	cursor->index = ownerSize(deque) - 1;
+}
+
+/**
+	Returns 1 if the cursor is on a value and 0 if it is past either end.
+	param:	cursor	struct CircularListCursor ptr
+	pre:	cursor was set by circularListCursorFront/Back
+	ret:	1 if on a value; otherwise, 0
+ */
+int circularListCursorValid(struct CircularListCursor* cursor)
+{
+	assert(cursor != NULL);
+	return cursor->index >= 0 && cursor->index < ownerSize(cursor->list);
+}
+
+/**
+	Moves the cursor to the next value.
+	param:	cursor	struct CircularListCursor ptr
+	pre:	cursor is on a value
+	post:	cursor index is incremented (past the back after the last)
+ */
+void circularListCursorNext(struct CircularListCursor* cursor)
+{
+	assert(circularListCursorValid(cursor));
+	cursor->index++;
+}
+
+/**
+	Moves the cursor to the previous value.
+	param:	cursor	struct CircularListCursor ptr
+	pre:	cursor is on a value
+	post:	cursor index is decremented (past the front after the first)
+ */
+void circularListCursorPrev(struct CircularListCursor* cursor)
+{
+	assert(circularListCursorValid(cursor));
+	cursor->index--;
+}
+
+/**
+	Returns the value the cursor is on.
+	param:	cursor	struct CircularListCursor ptr
+	pre:	cursor is on a value
+	ret:	value at the cursor's position
+ */
+TYPE circularListCursorGet(struct CircularListCursor* cursor)
+{
+	assert(circularListCursorValid(cursor));
+	struct CircularList* deque = cursor->list;
+	long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	return getValue(atomic_load_explicit(&deque->array, memory_order_relaxed), top + cursor->index);
+}
+
+/**
+	Removes the value the cursor is on, shifting the shorter side of
+	the deque over it; the cursor is then on the next value.
+	param:	cursor	struct CircularListCursor ptr
+	pre:	cursor is on a value
+	post:	the value is removed
+ */
+void circularListCursorErase(struct CircularListCursor* cursor)
+{
+	assert(circularListCursorValid(cursor));
+	struct CircularList* deque = cursor->list;
+	long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	struct Array* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+	long pos = cursor->index;
+	if (pos < bottom - top - 1 - pos) {
+		moveValues(array, top + 1, top, pos);
+		atomic_store_explicit(&deque->top, top + 1, memory_order_release);
+	}
+	else {
+		moveValues(array, top + pos, top + pos + 1, bottom - top - 1 - pos);
+		atomic_store_explicit(&deque->bottom, bottom - 1, memory_order_release);
+	}
+}
+
+/**
+	Adds the value before the one the cursor is on, or at the back if
+	the cursor is past either end, shifting the shorter side of the
+	deque to make room; the cursor stays where it is.
+	param:	cursor	struct CircularListCursor ptr
+	param: 	value 	TYPE
+	pre:	cursor was set by circularListCursorFront/Back
+	post:	value is before the cursor's value
+ */
+void circularListCursorInsert(struct CircularListCursor* cursor, TYPE value)
+{
+	assert(cursor != NULL);
+	struct CircularList* deque = cursor->list;
+	long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+	long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+	struct Array* array = atomic_load_explicit(&deque->array, memory_order_relaxed);
+	long pos = circularListCursorValid(cursor) ? cursor->index : bottom - top;
+	if (bottom - top + 1 > array->capacity) {
+		array = grow(deque, array, top, bottom);
+	}
+	//Open the gap at top + pos.
+	if (pos < bottom - top - pos) {
+		moveValues(array, top - 1, top, pos);
+		top--;
+	}
+	else {
+		moveValues(array, top + pos + 1, top + pos, bottom - top - pos);
+		bottom++;
+	}
+	putValue(array, top + pos, value);
+	atomic_store_explicit(&deque->top, top, memory_order_release);
+	atomic_store_explicit(&deque->bottom, bottom, memory_order_release);
+	if (cursor->index >= 0) {
+		cursor->index++;
+	}
+}
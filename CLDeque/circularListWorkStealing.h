@@ -0,0 +1,12 @@
+#ifndef CIRCULAR_LIST_WORK_STEALING_H
+#define CIRCULAR_LIST_WORK_STEALING_H
+
+#include "circularList.h"
+
+// Only in the work-stealing engine (circularListWorkStealing.c).
+// The owner thread uses the back; any thread may steal the front.
+
+int circularListTryRemoveBack(struct CircularList* list, TYPE* value);
+int circularListSteal(struct CircularList* list, TYPE* value);
+
+#endif
@@ -0,0 +1,916 @@
+/***********************************************************
+* Filename: dequeTemplate.h
+*
+* Overview:
+*   Macro template for type-specialized deques. Where circularList.h
+*	has one TYPE per build, DEQUE_DEFINE(name, type, lt, eq, format)
+*	writes out a whole deque for one element type, with every
+*	function named after name, so any number of element types live
+*	in one program:
+*
+*		DEQUE_DEFINE(intDeque, int, DEQUE_LT, DEQUE_EQ, DEQUE_FORMAT_INT)
+*		DEQUE_DEFINE(pointDeque, struct Point, pointLess, pointSame, pointFormat)
+*
+*	lt(A, B) orders values (for Sort) and eq(A, B) matches them (for
+*	Contains and Remove). format(out, room, value) writes value as
+*	text for Print and text Dumps, the way snprintf does: at most
+*	room characters, returning how many the value needs. Any of them
+*	may be a function-like macro or a function.
+*
+*	The deque is the ring buffer circularListRing.c is generated
+*	from (with DEQUE_DEFINE_STRUCT and DEQUE_DEFINE_FUNCTIONS): a
+*	power-of-two array that doubles when full, with the front at
+*	index start, an O(1) reversed flag, and splicing and cursors
+*	that shift the shorter side of a gap. With DEQUE_SHRINK defined
+*	it also halves once it is down to a quarter full. Every
+*	function DEQUE_DEFINE writes is static inline, so each
+*	instantiation is compiled, and can be inlined, for its own type
+*	and comparisons.
+*
+*	For DEQUE_DEFINE(name, ...) the generated interface is the one
+*	in circularList.h with circularList/CircularList replaced by
+*	name, plus:
+*		int nameSize(struct name* deque)
+*		type nameGet(struct name* deque, int pos)	0 is the front
+*		int nameContains(struct name* deque, type value)
+*		void nameRemove(struct name* deque, type value)
+*			(first value eq to it, if any)
+*	that is, Create/CreateFromArray/Destroy, the deque and splicing
+*	calls, Reverse/Materialize/Sort, Print/Dump/DumpFd (with
+*	DEQUE_DUMP_TEXT/DEQUE_DUMP_BINARY), the cursor calls on a
+*	struct nameCursor, Save/Load/ViewOpen/ViewClose on a struct
+*	nameView, and with -DCONTAINER_STATS nameGetStats on a struct
+*	nameStats. The pre/post conditions match circularList.h, and
+*	snapshots use the format of circularListSnapshot.c.
+*
+*	Only the ring deque is templated. Stacks have their own
+*	template, STACK_DEFINE in Stack_from_Queues/stackTemplate.h.
+*	LinkedList stays one TYPE per build: with its hash index, skip
+*	list, counted links and link blocks the three engines run to
+*	about 4000 lines, too much to keep as macro bodies. A program
+*	that needs lists of two element types can use DEQUE_DEFINE's
+*	Contains/Remove/Sort, or store pointers in one LinkedList.
+*
+* Usage:
+* 	#include "dequeTemplate.h" and DEQUE_DEFINE once per element
+*	type, at file scope, in each file that uses it. Define
+*	_POSIX_C_SOURCE first so views can advise sequential reads.
+************************************************************/
+#ifndef DEQUE_TEMPLATE_H
+#define DEQUE_TEMPLATE_H
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Capacity of a new deque; must be a power of two.
+#ifndef DEQUE_MIN_CAPACITY
+#define DEQUE_MIN_CAPACITY 16
+#endif
+
+// Size of the buffer a dump formats values into
+#ifndef DEQUE_DUMP_BYTES
+#define DEQUE_DUMP_BYTES 65536
+#endif
+
+// Dump modes (the same values as CIRCULAR_LIST_DUMP_TEXT/BINARY)
+#define DEQUE_DUMP_TEXT 0
+#define DEQUE_DUMP_BINARY 1
+
+// Comparisons for types that have < and ==, and formats for int and
+// double
+#define DEQUE_LT(A, B) ((A) < (B))
+#define DEQUE_EQ(A, B) ((A) == (B))
+#define DEQUE_FORMAT_INT(OUT, ROOM, V) snprintf((OUT), (ROOM), "%d", (V))
+#define DEQUE_FORMAT_DOUBLE(OUT, ROOM, V) snprintf((OUT), (ROOM), "%g", (V))
+
+#define DEQUE_STRINGIFY(X) #X
+#define DEQUE_TYPE_NAME(X) DEQUE_STRINGIFY(X)
+
+#ifdef DEQUE_SHRINK
+#define DEQUE_SHOULD_SHRINK(deque) \
+	((deque)->capacity > DEQUE_MIN_CAPACITY && (deque)->size <= (deque)->capacity / 4)
+#else
+#define DEQUE_SHOULD_SHRINK(deque) 0
+#endif
+
+#if defined(POSIX_MADV_SEQUENTIAL)
+#define DEQUE_ADVISE_SEQUENTIAL(map, bytes) posix_madvise((map), (bytes), POSIX_MADV_SEQUENTIAL)
+#else
+#define DEQUE_ADVISE_SEQUENTIAL(map, bytes) ((void)0)
+#endif
+
+// Operation counters (only when built with -DCONTAINER_STATS); the
+// fields match struct CircularListStats, counting arrays as nodes.
+#ifdef CONTAINER_STATS
+#define DEQUE_STAT(deque, field, n) ((deque)->stats.field += (n))
+#define DEQUE_STATS_INIT(deque, bytes) \
+	(memset(&(deque)->stats, 0, sizeof((deque)->stats)), \
+	(deque)->stats.nodesAllocated = 1, (deque)->stats.bytesLive = (long)(bytes))
+#define DEQUE_STATS_MEMBER(Tag) struct Tag##Stats stats;
+#define DEQUE_STATS_TYPE(Tag) \
+	struct Tag##Stats \
+	{ \
+		long addFront, addBack, removeFront, removeBack, front, back, reverse; \
+		long nodesAllocated, nodesFreed, bytesLive, nodesTraversed; \
+	};
+#define DEQUE_STATS_GET(Tag, prefix, scope) \
+	scope void prefix##GetStats(struct Tag* deque, struct Tag##Stats* stats) \
+	{ \
+		assert(deque != NULL && stats != NULL); \
+		*stats = deque->stats; \
+	}
+#else
+#define DEQUE_STAT(deque, field, n) ((void)0)
+#define DEQUE_STATS_INIT(deque, bytes) ((void)0)
+#define DEQUE_STATS_MEMBER(Tag)
+#define DEQUE_STATS_TYPE(Tag)
+#define DEQUE_STATS_GET(Tag, prefix, scope)
+#endif
+
+// Buffered writer behind every Dump and Print, the template's and
+// those of the circularList and linkedList engines (through
+// circularListDump.h and linkedListDump.h). Values are formatted into
+// one buffer of DEQUE_DUMP_BYTES that is written out each time it
+// fills, so a dump costs one fwrite (or write) per buffer instead of
+// one per value.
+struct DequeDump
+{
+	FILE* file;	//written with fwrite, or with write(fd) when NULL
+	int fd;
+	int binary;
+	int failed;
+	int len;
+	char* data;
+};
+
+/**
+	Allocates the buffer and points it at file, or at fd if file
+	is NULL.
+	param: 	buffer 	struct DequeDump ptr
+	param: 	file 	FILE ptr
+	param: 	fd 		int
+	param: 	mode 	DEQUE_DUMP_TEXT or DEQUE_DUMP_BINARY
+	pre: 	buffer is not NULL
+	post: 	buffer is empty
+ */
+static inline void dequeDumpOpen(struct DequeDump* buffer, FILE* file, int fd, int mode)
+{
+	assert(mode == DEQUE_DUMP_TEXT || mode == DEQUE_DUMP_BINARY);
+	buffer->file = file;
+	buffer->fd = fd;
+	buffer->binary = mode == DEQUE_DUMP_BINARY;
+	buffer->failed = 0;
+	buffer->len = 0;
+	buffer->data = malloc(DEQUE_DUMP_BYTES);
+	assert(buffer->data != 0);
+}
+
+/**
+	Writes out and empties the buffer. After a failed write the rest
+	of the dump is dropped.
+	param: 	buffer 	struct DequeDump ptr
+	pre: 	buffer was opened
+	post: 	buffer is empty; failed is set if a write failed
+ */
+static inline void dequeDumpFlush(struct DequeDump* buffer)
+{
+	char* next = buffer->data;
+	size_t left = buffer->failed ? 0 : (size_t)buffer->len;
+	if (buffer->file != NULL) {
+		if (fwrite(next, 1, left, buffer->file) != left) {
+			buffer->failed = 1;
+		}
+	}
+	else {
+		while (left > 0) {
+			ssize_t written = write(buffer->fd, next, left);
+			if (written < 0) {
+				if (errno == EINTR) continue;
+				buffer->failed = 1;
+				break;
+			}
+			next += written;
+			left -= (size_t)written;
+		}
+	}
+	buffer->len = 0;
+}
+
+/**
+	Writes out what is left in the buffer and frees it.
+	param: 	buffer 	struct DequeDump ptr
+	pre: 	buffer was opened
+	post: 	buffer memory is freed
+	ret: 	0 if every write succeeded; otherwise, -1 (errno is set by
+			the failed write)
+ */
+static inline int dequeDumpClose(struct DequeDump* buffer)
+{
+	dequeDumpFlush(buffer);
+	free(buffer->data);
+	return buffer->failed ? -1 : 0;
+}
+
+/**
+	Formats value in decimal, for formats that skip snprintf.
+	param: 	out 	char ptr, room for 20 characters
+	param: 	value 	long long
+	ret: 	number of characters written
+ */
+static inline int dequeFormatDecimal(char* out, long long value)
+{
+	char digits[20];
+	unsigned long long magnitude = value < 0 ? 0ull - (unsigned long long)value
+		: (unsigned long long)value;
+	int n = 0;
+	do {
+		digits[n++] = (char)('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude != 0);
+	int len = 0;
+	if (value < 0) {
+		out[len++] = '-';
+	}
+	while (n > 0) {
+		out[len++] = digits[--n];
+	}
+	return len;
+}
+
+// Header of a snapshot file (see circularListSnapshot.c)
+struct DequeSnapshotHeader
+{
+	char magic[8];
+	char type[12];
+	uint32_t valueBytes;
+	uint64_t count;
+};
+
+/**
+	Fills in the header of a snapshot of count values of the named
+	type.
+	param: 	header 		struct DequeSnapshotHeader ptr
+	param: 	type 		const char ptr, the type as spelled in the build
+	param: 	valueBytes 	size_t
+	param: 	count 		uint64_t
+	pre: 	header is not NULL
+	post: 	every byte of header is set
+ */
+static inline void dequeFillHeader(struct DequeSnapshotHeader* header, const char* type,
+	size_t valueBytes, uint64_t count)
+{
+	memset(header, 0, sizeof(struct DequeSnapshotHeader));
+	memcpy(header->magic, "DEQSNAP1", sizeof(header->magic));
+	strncpy(header->type, type, sizeof(header->type));
+	header->valueBytes = (uint32_t)valueBytes;
+	header->count = count;
+}
+
+// Writes fn(struct DequeDump* buffer, type value), which adds one
+// value to a dump buffer: its bytes in binary mode, otherwise the
+// text format writes for it and a newline.
+#define DEQUE_DEFINE_DUMP_VALUE(fn, type, format) \
+/* Adds one value to a dump buffer, writing the buffer out first if \
+   it is nearly full; a formatted value too long for what is left is \
+   retried in an empty buffer. */ \
+static inline void fn(struct DequeDump* buffer, type value) \
+{ \
+	if (DEQUE_DUMP_BYTES - buffer->len < 32 + (int)sizeof(type)) { \
+		dequeDumpFlush(buffer); \
+	} \
+	char* out = buffer->data + buffer->len; \
+	if (buffer->binary) { \
+		memcpy(out, &value, sizeof(type)); \
+		buffer->len += sizeof(type); \
+		return; \
+	} \
+	/* Keep one byte for the newline. */ \
+	int room = DEQUE_DUMP_BYTES - buffer->len - 1; \
+	int len = format(out, room, value); \
+	if (len >= room) { \
+		dequeDumpFlush(buffer); \
+		out = buffer->data; \
+		len = format(out, DEQUE_DUMP_BYTES - 1, value); \
+		assert(len < DEQUE_DUMP_BYTES - 1); \
+	} \
+	out[len] = '\n'; \
+	buffer->len += len + 1; \
+}
+
+// Writes struct Tag, the deque itself. circularListRing.c uses it
+// on its own, since circularList.h declares the other types.
+#define DEQUE_DEFINE_STRUCT(Tag, type) \
+struct Tag \
+{ \
+	int size; \
+	int capacity;	/* power of two */ \
+	int start;		/* index of the physical first value */ \
+	int reversed;	/* 1 if the front is at the physical back */ \
+	type* data; \
+	DEQUE_STATS_MEMBER(Tag) \
+};
+
+// Writes struct TagCursor, struct TagView and (with
+// -DCONTAINER_STATS) struct TagStats.
+#define DEQUE_DEFINE_TYPES(Tag, type) \
+struct Tag##Cursor \
+{ \
+	struct Tag* list; \
+	void* node;	/* unused; the position is index */ \
+	int index; \
+}; \
+ \
+struct Tag##View \
+{ \
+	const type* values; \
+	int size; \
+	void* map;		/* the whole mapped file */ \
+	size_t bytes;	/* " " */ \
+}; \
+ \
+DEQUE_STATS_TYPE(Tag)
+
+// Writes every deque function, named p##Create and so on, on
+// struct Tag, with the linkage given by scope (static inline, or
+// nothing for circularListRing.c's external definitions). Helpers are
+// always static inline.
+#define DEQUE_DEFINE_FUNCTIONS(Tag, p, type, lt, eq, format, scope) \
+/* Maps a physical position (0 is start) to an index in data. */ \
+static inline int p##Slot(struct Tag* deque, int pos) \
+{ \
+	return (deque->start + pos) & (deque->capacity - 1); \
+} \
+ \
+/* Maps a logical position (0 is the front) to an index in data, \
+   honoring the reversed flag. */ \
+static inline int p##LogicalSlot(struct Tag* deque, int pos) \
+{ \
+	return p##Slot(deque, deque->reversed ? deque->size - 1 - pos : pos); \
+} \
+ \
+/* Copies the values into a new array of the given capacity (a power \
+   of two >= size), physical first value at index 0, in at most two \
+   runs: start to the end of the array, then the wrap. */ \
+static inline void p##SetCapacity(struct Tag* deque, int capacity) \
+{ \
+	type* data = malloc(capacity * sizeof(type)); \
+	assert(data != NULL); \
+	int first = deque->capacity - deque->start; \
+	if (first > deque->size) { \
+		first = deque->size; \
+	} \
+	memcpy(data, deque->data + deque->start, first * sizeof(type)); \
+	memcpy(data + first, deque->data, (deque->size - first) * sizeof(type)); \
+	DEQUE_STAT(deque, nodesAllocated, 1); \
+	DEQUE_STAT(deque, nodesFreed, 1); \
+	DEQUE_STAT(deque, bytesLive, (long)((capacity - deque->capacity) * sizeof(type))); \
+	free(deque->data); \
+	deque->data = data; \
+	deque->capacity = capacity; \
+	deque->start = 0; \
+} \
+ \
+/* Doubles the array until it can hold n values. */ \
+static inline void p##Reserve(struct Tag* deque, int n) \
+{ \
+	int capacity = deque->capacity; \
+	while (capacity < n) { \
+		capacity *= 2; \
+	} \
+	if (capacity != deque->capacity) { \
+		p##SetCapacity(deque, capacity); \
+	} \
+} \
+ \
+/* Halves the array after a removal if DEQUE_SHRINK is defined and \
+   the deque only fills a quarter of it. */ \
+static inline void p##MaybeShrink(struct Tag* deque) \
+{ \
+	if (DEQUE_SHOULD_SHRINK(deque)) { \
+		p##SetCapacity(deque, deque->capacity / 2); \
+	} \
+} \
+ \
+/* Stores value before the physical first value. */ \
+static inline void p##AddFirst(struct Tag* deque, type value) \
+{ \
+	if (deque->size == deque->capacity) { \
+		p##SetCapacity(deque, 2 * deque->capacity); \
+	} \
+	deque->start = (deque->start - 1) & (deque->capacity - 1); \
+	deque->data[deque->start] = value; \
+	deque->size++; \
+} \
+ \
+/* Stores value after the physical last value. */ \
+static inline void p##AddLast(struct Tag* deque, type value) \
+{ \
+	if (deque->size == deque->capacity) { \
+		p##SetCapacity(deque, 2 * deque->capacity); \
+	} \
+	deque->data[p##Slot(deque, deque->size)] = value; \
+	deque->size++; \
+} \
+ \
+/* Moves the values at physical positions [from, from + n) to \
+   [to, to + n); the ranges may overlap. */ \
+static inline void p##MoveValues(struct Tag* deque, int to, int from, int n) \
+{ \
+	DEQUE_STAT(deque, nodesTraversed, n); \
+	if (to < from) { \
+		for (int i = 0; i < n; i++) { \
+			deque->data[p##Slot(deque, to + i)] = deque->data[p##Slot(deque, from + i)]; \
+		} \
+	} \
+	else { \
+		for (int i = n - 1; i >= 0; i--) { \
+			deque->data[p##Slot(deque, to + i)] = deque->data[p##Slot(deque, from + i)]; \
+		} \
+	} \
+} \
+ \
+scope struct Tag* p##Create() \
+{ \
+	struct Tag* deque = malloc(sizeof(struct Tag)); \
+	assert(deque != NULL); \
+	deque->data = malloc(DEQUE_MIN_CAPACITY * sizeof(type)); \
+	assert(deque->data != NULL); \
+	deque->capacity = DEQUE_MIN_CAPACITY; \
+	deque->start = 0; \
+	deque->size = 0; \
+	deque->reversed = 0; \
+	DEQUE_STATS_INIT(deque, sizeof(struct Tag) + DEQUE_MIN_CAPACITY * sizeof(type)); \
+	return deque; \
+} \
+ \
+/* Sizes the array for all n values once and copies them in with \
+   one memcpy. */ \
+scope struct Tag* p##CreateFromArray(const type* values, int n) \
+{ \
+	assert(n >= 0 && (values != NULL || n == 0)); \
+	struct Tag* deque = p##Create(); \
+	p##Reserve(deque, n); \
+	if (n > 0) { \
+		memcpy(deque->data, values, n * sizeof(type)); \
+	} \
+	deque->size = n; \
+	return deque; \
+} \
+ \
+scope void p##Destroy(struct Tag* deque) \
+{ \
+	assert(deque != NULL); \
+	free(deque->data); \
+	free(deque); \
+} \
+ \
+scope int p##IsEmpty(struct Tag* deque) \
+{ \
+	assert(deque != NULL); \
+	return deque->size == 0; \
+} \
+ \
+scope int p##Size(struct Tag* deque) \
+{ \
+	assert(deque != NULL); \
+	return deque->size; \
+} \
+ \
+scope void p##AddFront(struct Tag* deque, type value) \
+{ \
+	assert(deque != NULL); \
+	DEQUE_STAT(deque, addFront, 1); \
+	if (deque->reversed) \
+		p##AddLast(deque, value); \
+	else \
+		p##AddFirst(deque, value); \
+} \
+ \
+scope void p##AddBack(struct Tag* deque, type value) \
+{ \
+	assert(deque != NULL); \
+	DEQUE_STAT(deque, addBack, 1); \
+	if (deque->reversed) \
+		p##AddFirst(deque, value); \
+	else \
+		p##AddLast(deque, value); \
+} \
+ \
+scope type p##Front(struct Tag* deque) \
+{ \
+	assert(deque != NULL && deque->size > 0); \
+	DEQUE_STAT(deque, front, 1); \
+	return deque->data[p##LogicalSlot(deque, 0)]; \
+} \
+ \
+scope type p##Back(struct Tag* deque) \
+{ \
+	assert(deque != NULL && deque->size > 0); \
+	DEQUE_STAT(deque, back, 1); \
+	return deque->data[p##LogicalSlot(deque, deque->size - 1)]; \
+} \
+ \
+scope type p##Get(struct Tag* deque, int pos) \
+{ \
+	assert(deque != NULL && pos >= 0 && pos < deque->size); \
+	return deque->data[p##LogicalSlot(deque, pos)]; \
+} \
+ \
+scope void p##RemoveFront(struct Tag* deque) \
+{ \
+	assert(deque != NULL && deque->size > 0); \
+	DEQUE_STAT(deque, removeFront, 1); \
+	if (!deque->reversed) { \
+		deque->start = p##Slot(deque, 1); \
+	} \
+	deque->size--; \
+	p##MaybeShrink(deque); \
+} \
+ \
+scope void p##RemoveBack(struct Tag* deque) \
+{ \
+	assert(deque != NULL && deque->size > 0); \
+	DEQUE_STAT(deque, removeBack, 1); \
+	if (deque->reversed) { \
+		deque->start = p##Slot(deque, 1); \
+	} \
+	deque->size--; \
+	p##MaybeShrink(deque); \
+} \
+ \
+scope int p##Contains(struct Tag* deque, type value) \
+{ \
+	assert(deque != NULL); \
+	for (int i = 0; i < deque->size; i++) { \
+		if (eq(deque->data[p##Slot(deque, i)], value)) return 1; \
+	} \
+	return 0; \
+} \
+ \
+/* O(1): flips the reversed flag (see Materialize). */ \
+scope void p##Reverse(struct Tag* deque) \
+{ \
+	assert(deque != NULL && deque->size != 0); \
+	DEQUE_STAT(deque, reverse, 1); \
+	deque->reversed = !deque->reversed; \
+} \
+ \
+/* Swaps the values from both ends towards the middle so that the \
+   physical order matches the logical order, and clears the reversed \
+   flag. Does nothing unless the deque is reversed. */ \
+scope void p##Materialize(struct Tag* deque) \
+{ \
+	assert(deque != NULL); \
+	if (!deque->reversed) return; \
+	deque->reversed = 0; \
+	DEQUE_STAT(deque, nodesTraversed, deque->size); \
+	for (int i = 0, j = deque->size - 1; i < j; i++, j--) { \
+		type tmp = deque->data[p##Slot(deque, i)]; \
+		deque->data[p##Slot(deque, i)] = deque->data[p##Slot(deque, j)]; \
+		deque->data[p##Slot(deque, j)] = tmp; \
+	} \
+} \
+ \
+/* Removes the logical first value eq to value, if any, by shifting \
+   whichever side of it is shorter. */ \
+scope void p##Remove(struct Tag* deque, type value) \
+{ \
+	assert(deque != NULL); \
+	int pos = 0; \
+	while (pos < deque->size && !eq(deque->data[p##LogicalSlot(deque, pos)], value)) { \
+		pos++; \
+	} \
+	if (pos == deque->size) return; \
+	p##Materialize(deque); \
+	if (pos < deque->size - 1 - pos) { \
+		p##MoveValues(deque, 1, 0, pos); \
+		deque->start = (deque->start + 1) & (deque->capacity - 1); \
+	} \
+	else { \
+		p##MoveValues(deque, pos, pos + 1, deque->size - 1 - pos); \
+	} \
+	deque->size--; \
+	p##MaybeShrink(deque); \
+} \
+ \
+/* Stable bottom-up merge sort by lt over the values in place. Each \
+   merge copies its shorter run into one scratch array of size / 2 \
+   values and merges it with the other run back into the deque: \
+   front to back if the left run was copied, back to front if the \
+   right one was (ties take the left run either way). */ \
+scope void p##Sort(struct Tag* deque) \
+{ \
+	assert(deque != NULL); \
+	int n = deque->size; \
+	if (n < 2) return; \
+	type* scratch = malloc((n / 2) * sizeof(type)); \
+	assert(scratch != NULL); \
+	type* data = deque->data; \
+	for (int width = 1; width < n; width *= 2) { \
+		for (int lo = 0; lo + width < n; lo += 2 * width) { \
+			int mid = lo + width; \
+			int hi = mid + width < n ? mid + width : n; \
+			DEQUE_STAT(deque, nodesTraversed, hi - lo); \
+			if (width <= hi - mid) { \
+				for (int k = 0; k < width; k++) { \
+					scratch[k] = data[p##LogicalSlot(deque, lo + k)]; \
+				} \
+				int a = 0, b = mid, out = lo; \
+				while (a < width) { \
+					if (b < hi && lt(data[p##LogicalSlot(deque, b)], scratch[a])) \
+						data[p##LogicalSlot(deque, out++)] = data[p##LogicalSlot(deque, b++)]; \
+					else \
+						data[p##LogicalSlot(deque, out++)] = scratch[a++]; \
+				} \
+			} \
+			else { \
+				for (int k = 0; k < hi - mid; k++) { \
+					scratch[k] = data[p##LogicalSlot(deque, mid + k)]; \
+				} \
+				int a = mid, b = hi - mid, out = hi; \
+				while (b > 0) { \
+					if (a > lo && lt(scratch[b - 1], data[p##LogicalSlot(deque, a - 1)])) \
+						data[p##LogicalSlot(deque, --out)] = data[p##LogicalSlot(deque, --a)]; \
+					else \
+						data[p##LogicalSlot(deque, --out)] = scratch[--b]; \
+				} \
+			} \
+		} \
+	} \
+	free(scratch); \
+} \
+ \
+DEQUE_DEFINE_DUMP_VALUE(p##DumpValue, type, format) \
+ \
+static inline void p##DumpValues(struct Tag* deque, struct DequeDump* buffer) \
+{ \
+	for (int i = 0; i < deque->size; i++) { \
+		p##DumpValue(buffer, deque->data[p##LogicalSlot(deque, i)]); \
+	} \
+} \
+ \
+scope int p##Dump(struct Tag* deque, FILE* out, int mode) \
+{ \
+	assert(deque != NULL && out != NULL); \
+	struct DequeDump buffer; \
+	dequeDumpOpen(&buffer, out, -1, mode); \
+	p##DumpValues(deque, &buffer); \
+	return dequeDumpClose(&buffer); \
+} \
+ \
+scope int p##DumpFd(struct Tag* deque, int fd, int mode) \
+{ \
+	assert(deque != NULL); \
+	struct DequeDump buffer; \
+	dequeDumpOpen(&buffer, NULL, fd, mode); \
+	p##DumpValues(deque, &buffer); \
+	return dequeDumpClose(&buffer); \
+} \
+ \
+scope void p##Print(struct Tag* deque) \
+{ \
+	p##Dump(deque, stdout, DEQUE_DUMP_TEXT); \
+} \
+ \
+/* Copies count values of src from position first into dst before \
+   position pos. The gap opened in dst and the one closed in src \
+   each shift the shorter side of it, and dst grows first if it \
+   needs the room. */ \
+scope void p##Splice(struct Tag* dst, int pos, struct Tag* src, int first, int count) \
+{ \
+	assert(dst != NULL && src != NULL && dst != src); \
+	assert(pos >= 0 && pos <= dst->size); \
+	assert(first >= 0 && count >= 0 && first + count <= src->size); \
+	if (count == 0) return; \
+	p##Materialize(dst); \
+	p##Materialize(src); \
+	p##Reserve(dst, dst->size + count); \
+	if (pos < dst->size - pos) { \
+		dst->start = (dst->start - count) & (dst->capacity - 1); \
+		p##MoveValues(dst, 0, count, pos); \
+	} \
+	else { \
+		p##MoveValues(dst, pos + count, pos, dst->size - pos); \
+	} \
+	dst->size += count; \
+	for (int i = 0; i < count; i++) { \
+		dst->data[p##Slot(dst, pos + i)] = src->data[p##Slot(src, first + i)]; \
+	} \
+	DEQUE_STAT(dst, nodesTraversed, count); \
+	int after = src->size - first - count; \
+	if (first < after) { \
+		p##MoveValues(src, count, 0, first); \
+		src->start = (src->start + count) & (src->capacity - 1); \
+	} \
+	else { \
+		p##MoveValues(src, first, first + count, after); \
+	} \
+	src->size -= count; \
+	p##MaybeShrink(src); \
+} \
+ \
+scope void p##Concat(struct Tag* dst, struct Tag* src) \
+{ \
+	assert(dst != NULL && src != NULL && dst != src); \
+	p##Splice(dst, dst->size, src, 0, src->size); \
+} \
+ \
+scope struct Tag* p##SplitAt(struct Tag* deque, int k) \
+{ \
+	assert(deque != NULL && k >= 0 && k <= deque->size); \
+	struct Tag* rest = p##Create(); \
+	p##Splice(rest, 0, deque, k, deque->size - k); \
+	return rest; \
+} \
+ \
+/* A cursor holds a logical position, so stepping through the deque \
+   reads the array in order and needs no prefetch hints. */ \
+scope void p##CursorFront(struct Tag* deque, struct Tag##Cursor* cursor) \
+{ \
+	assert(deque != NULL && cursor != NULL); \
+	cursor->list = deque; \
+	cursor->node = NULL; \
+	cursor->index = 0; \
+} \
+ \
+scope void p##CursorBack(struct Tag* deque, struct Tag##Cursor* cursor) \
+{ \
+	assert(deque != NULL && cursor != NULL); \
+	cursor->list = deque; \
+	cursor->node = NULL; \
+	cursor->index = deque->size - 1; \
+} \
+ \
+scope int p##CursorValid(struct Tag##Cursor* cursor) \
+{ \
+	assert(cursor != NULL); \
+	return cursor->index >= 0 && cursor->index < cursor->list->size; \
+} \
+ \
+scope void p##CursorNext(struct Tag##Cursor* cursor) \
+{ \
+	assert(p##CursorValid(cursor)); \
+	cursor->index++; \
+} \
+ \
+scope void p##CursorPrev(struct Tag##Cursor* cursor) \
+{ \
+	assert(p##CursorValid(cursor)); \
+	cursor->index--; \
+} \
+ \
+scope type p##CursorGet(struct Tag##Cursor* cursor) \
+{ \
+	assert(p##CursorValid(cursor)); \
+	return cursor->list->data[p##LogicalSlot(cursor->list, cursor->index)]; \
+} \
+ \
+/* Removes the value the cursor is on, shifting the shorter side \
+   over it; the cursor is then on the next value. */ \
+scope void p##CursorErase(struct Tag##Cursor* cursor) \
+{ \
+	assert(p##CursorValid(cursor)); \
+	struct Tag* deque = cursor->list; \
+	int pos = cursor->index; \
+	p##Materialize(deque); \
+	if (pos < deque->size - 1 - pos) { \
+		p##MoveValues(deque, 1, 0, pos); \
+		deque->start = (deque->start + 1) & (deque->capacity - 1); \
+	} \
+	else { \
+		p##MoveValues(deque, pos, pos + 1, deque->size - 1 - pos); \
+	} \
+	deque->size--; \
+	p##MaybeShrink(deque); \
+} \
+ \
+/* Adds value before the cursor's value (at the back if the cursor \
+   is past either end), shifting the shorter side to make room; the \
+   cursor stays on its value. */ \
+scope void p##CursorInsert(struct Tag##Cursor* cursor, type value) \
+{ \
+	assert(cursor != NULL); \
+	struct Tag* deque = cursor->list; \
+	int pos = p##CursorValid(cursor) ? cursor->index : deque->size; \
+	p##Materialize(deque); \
+	p##Reserve(deque, deque->size + 1); \
+	if (pos < deque->size - pos) { \
+		deque->start = (deque->start - 1) & (deque->capacity - 1); \
+		p##MoveValues(deque, 0, 1, pos); \
+	} \
+	else { \
+		p##MoveValues(deque, pos + 1, pos, deque->size - pos); \
+	} \
+	deque->data[p##Slot(deque, pos)] = value; \
+	deque->size++; \
+	if (cursor->index >= 0) { \
+		cursor->index++; \
+	} \
+} \
+ \
+DEQUE_STATS_GET(Tag, p, scope)
+
+// Writes Save, Load, ViewOpen and ViewClose in the snapshot format of
+// circularListSnapshot.c. They only need p##Dump, p##CreateFromArray
+// and struct Tag##View, so besides the template's own deques they
+// serve circularList.h and linkedList.h (linkedListSnapshot.c).
+#define DEQUE_DEFINE_SNAPSHOT(Tag, p, type, scope) \
+/* Writes the values, front to back, to a snapshot file at path, \
+   replacing any file there; the count is filled in once they are \
+   written. Returns 0, or -1 with errno set. */ \
+scope int p##Save(struct Tag* deque, const char* path) \
+{ \
+	assert(deque != NULL && path != NULL); \
+	FILE* file = fopen(path, "wb"); \
+	if (file == NULL) return -1; \
+	struct DequeSnapshotHeader header; \
+	dequeFillHeader(&header, DEQUE_TYPE_NAME(type), sizeof(type), 0); \
+	int failed = fwrite(&header, sizeof(header), 1, file) != 1 \
+		|| p##Dump(deque, file, DEQUE_DUMP_BINARY) != 0; \
+	if (!failed) { \
+		long end = ftell(file); \
+		dequeFillHeader(&header, DEQUE_TYPE_NAME(type), sizeof(type), \
+			(uint64_t)(end - (long)sizeof(header)) / sizeof(type)); \
+		failed = end < 0 || fseek(file, 0, SEEK_SET) != 0 \
+			|| fwrite(&header, sizeof(header), 1, file) != 1; \
+	} \
+	if (fclose(file) != 0) { \
+		failed = 1; \
+	} \
+	return failed ? -1 : 0; \
+} \
+ \
+/* Maps the snapshot file at path read-only and checks its header \
+   against type. Returns 0, or -1 with errno set. */ \
+scope int p##ViewOpen(struct Tag##View* view, const char* path) \
+{ \
+	assert(view != NULL && path != NULL); \
+	int fd = open(path, O_RDONLY); \
+	if (fd < 0) return -1; \
+	struct stat info; \
+	void* map = MAP_FAILED; \
+	if (fstat(fd, &info) == 0) { \
+		if (info.st_size >= (off_t)sizeof(struct DequeSnapshotHeader)) { \
+			map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0); \
+		} \
+		else { \
+			errno = EINVAL; \
+		} \
+	} \
+	close(fd); \
+	if (map == MAP_FAILED) return -1; \
+	const struct DequeSnapshotHeader* header = map; \
+	struct DequeSnapshotHeader expected; \
+	dequeFillHeader(&expected, DEQUE_TYPE_NAME(type), sizeof(type), header->count); \
+	if (memcmp(header, &expected, sizeof(expected)) != 0 || header->count > INT_MAX \
+		|| (uint64_t)info.st_size != sizeof(expected) + header->count * sizeof(type)) { \
+		munmap(map, (size_t)info.st_size); \
+		errno = EINVAL; \
+		return -1; \
+	} \
+	DEQUE_ADVISE_SEQUENTIAL(map, (size_t)info.st_size); \
+	view->values = (const type*)(header + 1); \
+	view->size = (int)header->count; \
+	view->map = map; \
+	view->bytes = (size_t)info.st_size; \
+	return 0; \
+} \
+ \
+scope void p##ViewClose(struct Tag##View* view) \
+{ \
+	assert(view != NULL && view->map != NULL); \
+	munmap(view->map, view->bytes); \
+	view->values = NULL; \
+	view->size = 0; \
+	view->map = NULL; \
+	view->bytes = 0; \
+} \
+ \
+/* Builds a deque from a snapshot in one call to CreateFromArray. \
+   Returns NULL (errno set) if the file is not a snapshot of type. */ \
+scope struct Tag* p##Load(const char* path) \
+{ \
+	struct Tag##View view; \
+	if (p##ViewOpen(&view, path) != 0) return NULL; \
+	struct Tag* deque = p##CreateFromArray(view.values, view.size); \
+	p##ViewClose(&view); \
+	return deque; \
+}
+
+// The whole deque for one element type, every function static inline
+#define DEQUE_DEFINE(name, type, lt, eq, format) \
+	DEQUE_DEFINE_TYPES(name, type) \
+	DEQUE_DEFINE_STRUCT(name, type) \
+	DEQUE_DEFINE_FUNCTIONS(name, name, type, lt, eq, format, static inline) \
+	DEQUE_DEFINE_SNAPSHOT(name, name, type, static inline)
+
+#endif
@@ -0,0 +1,145 @@
+/***********************************************************
+* Filename: dequeTemplateMain.c
+*
+* Overview:
+*   Tests the deque template (dequeTemplate.h) with three element
+*	types in one program: int, double, and a struct compared by
+*	one field, which also checks that Sort is stable. Then the calls
+*	the template shares with circularList.h: reverse, splicing,
+*	cursors, dumps and snapshots.
+*
+* Usage:
+* 	1) make -f makefilecirListDeque template
+*	2) ./template
+************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include "dequeTemplate.h"
+#include <stdio.h>
+
+struct Job {
+	int priority;
+	int id;
+};
+
+#define JOB_LT(A, B) ((A).priority < (B).priority)
+#define JOB_EQ(A, B) ((A).id == (B).id)
+#define JOB_FORMAT(OUT, ROOM, V) snprintf((OUT), (ROOM), "%d:%d", (V).priority, (V).id)
+
+DEQUE_DEFINE(intDeque, int, DEQUE_LT, DEQUE_EQ, DEQUE_FORMAT_INT)
+DEQUE_DEFINE(doubleDeque, double, DEQUE_LT, DEQUE_EQ, DEQUE_FORMAT_DOUBLE)
+DEQUE_DEFINE(jobDeque, struct Job, JOB_LT, JOB_EQ, JOB_FORMAT)
+
+void assertTrue(int pred, char* msg)
+{
+	printf("%s: ", msg);
+	if(pred)
+		printf("\tPASSED\n");
+	else
+		printf("\tFAILED\n");
+}
+
+int main()
+{
+	printf("\n-------------------------------------------------\n");
+	printf("----------- Testing the deque template ----------\n");
+	printf("-------------------------------------------------\n");
+
+	struct intDeque* ints = intDequeCreate();
+	assertTrue(intDequeIsEmpty(ints), "int isEmpty == 1");
+	for (int i = 0; i < 100; i++) {
+		intDequeAddBack(ints, i);
+		intDequeAddFront(ints, -i);
+	}
+	assertTrue(intDequeSize(ints) == 200, "int size == 200 (grown past 16)");
+	assertTrue(intDequeFront(ints) == -99 && intDequeBack(ints) == 99, "int front == -99, back == 99");
+	intDequeRemove(ints, 0);
+	assertTrue(intDequeContains(ints, 0), "int remove takes one 0 of two");
+	intDequeRemove(ints, 0);
+	assertTrue(!intDequeContains(ints, 0) && intDequeSize(ints) == 198, "int remove takes the other");
+	intDequeRemoveFront(ints);
+	intDequeRemoveBack(ints);
+	intDequeSort(ints);
+	int sorted = 1;
+	for (int i = 1; i < intDequeSize(ints); i++) {
+		if (intDequeGet(ints, i - 1) > intDequeGet(ints, i)) sorted = 0;
+	}
+	assertTrue(sorted && intDequeFront(ints) == -98, "int sort");
+	intDequeDestroy(ints);
+
+	struct doubleDeque* doubles = doubleDequeCreate();
+	doubleDequeAddBack(doubles, 2.5);
+	doubleDequeAddFront(doubles, 0.5);
+	doubleDequeAddBack(doubles, 1.5);
+	doubleDequeSort(doubles);
+	assertTrue(doubleDequeGet(doubles, 0) == 0.5 && doubleDequeGet(doubles, 1) == 1.5
+		&& doubleDequeGet(doubles, 2) == 2.5, "double sort == 0.5, 1.5, 2.5");
+	doubleDequeDestroy(doubles);
+
+	struct jobDeque* jobs = jobDequeCreate();
+	for (int id = 0; id < 40; id++) {
+		struct Job job = {id % 4, id};
+		//Wrap the ring before sorting.
+		if (id % 2) jobDequeAddBack(jobs, job);
+		else jobDequeAddFront(jobs, job);
+	}
+	struct Job seventeen = {1, 17};
+	assertTrue(jobDequeContains(jobs, seventeen), "job contains id 17");
+	jobDequeSort(jobs);
+	int stable = 1;
+	for (int i = 1; i < jobDequeSize(jobs); i++) {
+		struct Job a = jobDequeGet(jobs, i - 1), b = jobDequeGet(jobs, i);
+		if (a.priority > b.priority) stable = 0;
+		//Equal priorities keep their order from before the sort:
+		//even ids (added at the front) descending, then odd ascending.
+		if (a.priority == b.priority && a.id % 2 == b.id % 2
+			&& (a.id % 2 ? a.id > b.id : a.id < b.id)) stable = 0;
+	}
+	assertTrue(stable, "job sort by priority is stable");
+	jobDequeDestroy(jobs);
+
+	ints = intDequeCreate();
+	for (int i = 0; i < 10; i++) {
+		intDequeAddBack(ints, i);
+	}
+	intDequeReverse(ints);
+	assertTrue(intDequeFront(ints) == 9 && intDequeGet(ints, 1) == 8, "int reverse");
+	intDequeMaterialize(ints);
+	assertTrue(intDequeFront(ints) == 9 && intDequeBack(ints) == 0, "int materialize keeps the order");
+	struct intDeque* rest = intDequeSplitAt(ints, 4);
+	assertTrue(intDequeSize(ints) == 4 && intDequeFront(rest) == 5, "int splitAt 4");
+	intDequeSplice(ints, 2, rest, 0, 3);
+	assertTrue(intDequeSize(ints) == 7 && intDequeGet(ints, 2) == 5 && intDequeGet(ints, 5) == 7,
+		"int splice 3 values at 2");
+	intDequeConcat(ints, rest);
+	assertTrue(intDequeIsEmpty(rest) && intDequeBack(ints) == 0, "int concat");
+	intDequeDestroy(rest);
+
+	struct intDequeCursor cursor;
+	intDequeCursorFront(ints, &cursor);
+	intDequeCursorNext(&cursor);
+	intDequeCursorErase(&cursor);
+	intDequeCursorInsert(&cursor, 42);
+	assertTrue(intDequeCursorGet(&cursor) == 5 && intDequeGet(ints, 1) == 42,
+		"int cursor erase and insert");
+
+	char text[64] = {0};
+	FILE* out = fmemopen(text, sizeof(text) - 1, "w");
+	intDequeDump(ints, out, DEQUE_DUMP_TEXT);
+	fclose(out);
+	assertTrue(strncmp(text, "9\n42\n5\n", 7) == 0, "int text dump");
+
+	const char* path = "dequeTemplate.snap";
+	assertTrue(intDequeSave(ints, path) == 0, "int save");
+	struct intDeque* loaded = intDequeLoad(path);
+	int same = loaded != NULL && intDequeSize(loaded) == intDequeSize(ints);
+	for (int i = 0; same && i < intDequeSize(ints); i++) {
+		same = intDequeGet(loaded, i) == intDequeGet(ints, i);
+	}
+	assertTrue(same, "int load matches save");
+	assertTrue(doubleDequeLoad(path) == NULL, "double load refuses an int snapshot");
+	remove(path);
+	intDequeDestroy(loaded);
+	intDequeDestroy(ints);
+
+	return 0;
+}
@@ -0,0 +1,173 @@
+/***********************************************************
+* Filename: workStealingMain.c
+*
+* Overview:
+*   Task pool demo and throughput benchmark for the work-stealing
+*	deque in circularListWorkStealing.c.
+*	Every worker thread owns one deque. A task is a number n:
+*	running it either adds n to the result (n < 2) or pushes the
+*	tasks n - 1 and n - 2 onto the worker's own deque, so running
+*	task n adds up to fib(n). Workers pop their own deque from the
+*	back and, when it is empty, steal from the front of a random
+*	other worker's deque.
+*	The demo checks the result against a plain loop; the benchmark
+*	reruns the pool with 1 to MAX_WORKERS workers and prints tasks
+*	per second and the number of successful steals.
+*
+* Usage:
+* 	1) make -f makefilecirListDeque work_stealing
+*	2) ./work_stealing
+************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include "circularListWorkStealing.h"
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <time.h>
+
+#define MAX_WORKERS 8
+#define DEMO_TASK 20
+#define BENCH_TASK 27
+
+struct Worker {
+	pthread_t thread;
+	int id;
+	unsigned int seed;
+	long tasks;
+	long steals;
+	struct CircularList* deque;
+};
+
+struct Worker workers[MAX_WORKERS];
+int workerCount;
+atomic_long pending;	//tasks pushed but not yet run
+atomic_long result;
+
+void assertTrue(int pred, char* msg)
+{
+	printf("%s: ", msg);
+	if(pred)
+		printf("\tPASSED\n");
+	else
+		printf("\tFAILED\n");
+}
+
+void runTask(struct Worker* self, TYPE task)
+{
+	long n = (long)task;
+	if (n < 2) {
+		atomic_fetch_add_explicit(&result, n, memory_order_relaxed);
+	}
+	else {
+		atomic_fetch_add_explicit(&pending, 2, memory_order_relaxed);
+		circularListAddBack(self->deque, (TYPE)(n - 1));
+		circularListAddBack(self->deque, (TYPE)(n - 2));
+	}
+	self->tasks++;
+	atomic_fetch_sub_explicit(&pending, 1, memory_order_release);
+}
+
+void* workerLoop(void* arg)
+{
+	struct Worker* self = (struct Worker*)arg;
+	while (atomic_load_explicit(&pending, memory_order_acquire) > 0) {
+		TYPE task;
+		if (circularListTryRemoveBack(self->deque, &task)) {
+			runTask(self, task);
+			continue;
+		}
+		if (workerCount > 1) {
+			self->seed = self->seed * 1103515245u + 12345u;
+			int victim = (int)((self->seed >> 16) % (unsigned int)(workerCount - 1));
+			if (victim >= self->id) victim++;
+			if (circularListSteal(workers[victim].deque, &task)) {
+				self->steals++;
+				runTask(self, task);
+				continue;
+			}
+		}
+		sched_yield();
+	}
+	return NULL;
+}
+
+/**
+	Runs task n on a pool of count workers and returns the seconds
+	it took. Worker 0's deque is seeded with the task.
+ */
+double runPool(int count, long n)
+{
+	workerCount = count;
+	atomic_store(&pending, 1);
+	atomic_store(&result, 0);
+	for (int i = 0; i < count; i++) {
+		workers[i].id = i;
+		workers[i].seed = 7u * (unsigned int)i + 1u;
+		workers[i].tasks = workers[i].steals = 0;
+		workers[i].deque = circularListCreate();
+	}
+	circularListAddBack(workers[0].deque, (TYPE)n);
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < count; i++) {
+		pthread_create(&workers[i].thread, NULL, workerLoop, &workers[i]);
+	}
+	for (int i = 0; i < count; i++) {
+		pthread_join(workers[i].thread, NULL);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	for (int i = 0; i < count; i++) {
+		circularListDestroy(workers[i].deque);
+	}
+	return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+long fib(long n)
+{
+	long a = 0, b = 1;
+	for (long i = 0; i < n; i++) {
+		long c = a + b;
+		a = b;
+		b = c;
+	}
+	return a;
+}
+
+int main()
+{
+	printf("\n-------------------------------------------------\n");
+	printf("--------- Work-stealing deque task pool ---------\n");
+	printf("-------------------------------------------------\n");
+
+	struct CircularList* deque = circularListCreate();
+	TYPE value;
+	for (int i = 0; i < 100; i++) {
+		circularListAddBack(deque, (TYPE)i);
+	}
+	assertTrue(circularListSteal(deque, &value) && value == 0, "steal; val == 0");
+	assertTrue(circularListTryRemoveBack(deque, &value) && value == 99, "pop; val == 99");
+	assertTrue(circularListFront(deque) == 1, "front val == 1");
+	assertTrue(circularListBack(deque) == 98, "back val == 98");
+	circularListDestroy(deque);
+
+	printf("\ndemo: task %d on 4 workers...\n", DEMO_TASK);
+	runPool(4, DEMO_TASK);
+	assertTrue(atomic_load(&result) == fib(DEMO_TASK), "result == fib(n)");
+
+	printf("\nbenchmark: task %d\n", BENCH_TASK);
+	printf("workers\tseconds\tMtasks/s\tsteals\n");
+	for (int count = 1; count <= MAX_WORKERS; count *= 2) {
+		double seconds = runPool(count, BENCH_TASK);
+		long tasks = 0, steals = 0;
+		for (int i = 0; i < count; i++) {
+			tasks += workers[i].tasks;
+			steals += workers[i].steals;
+		}
+		assert(atomic_load(&result) == fib(BENCH_TASK));
+		printf("%d\t%.3f\t%.2f\t\t%ld\n", count, seconds, tasks / seconds / 1e6, steals);
+	}
+
+	return 0;
+}
@@ -23,6 +23,56 @@
 *	Note that both implementations utilize a linked list with
 *	both a front and back sentinel and double links (links with
 *	next and prev pointers).
+*
+*	Links (sentinels included) are not malloc'd one at a time;
+*	each list owns a small pool that carves links out of large
+*	blocks and recycles removed links through a free list. The
+*	blocks are only given back to the system when the list is
+*	destroyed.
+*
+*	A list made with linkedListCreateHashed also keeps a hash
+*	index (open addressing, linear probing) with one entry per
+*	link, so bag contains/remove take O(1) expected time instead
+*	of scanning. The index is kept up to date by addLinkBefore
+*	and removeLink, so every deque operation works unchanged.
+*
+*	A list made with linkedListCreateCounted is a hashed list that
+*	collapses duplicates: each distinct value has one link, and its
+*	index entry counts the occurrences. Adding a value that is
+*	already there (linkedListAdd, linkedListAddMany, or a deque add)
+*	only bumps the count, and removing (bag or deque) drops one
+*	occurrence, unlinking the link with the last one. Size and
+*	memory follow the distinct values; Print repeats each value
+*	count times.
+*
+*	A list made with linkedListCreateSorted keeps its links in LT
+*	order and a skip list index over them: about one link in four
+*	gets a tower of forward pointers (SKIP_MAX_LEVEL at most), and
+*	a search walks the towers down to the last link before the
+*	value, so bag add/contains/remove and range queries take
+*	O(log n) expected time. Deque adds, bulk adds and cursor inserts
+*	go through the same sorted insert, so nothing can put a link
+*	out of order. Print needs no change since the links themselves
+*	are in order.
+*
+*	The bulk functions (linkedListCreateFromArray, AddBackN/AddFrontN,
+*	RemoveFrontN/RemoveBackN) reserve the links they need up front
+*	and link or unlink the whole run in one pass, touching the
+*	sentinel and its neighbour only once.
+*
+*	linkedListSort is a stable bottom-up merge sort by LT that
+*	relinks the existing links, so it allocates nothing and the
+*	hash index (which points at links) stays valid.
+*
+*	A cursor holds a link (a sentinel once it is past either end).
+*	Every move prefetches the link after the new one, so its cache
+*	miss overlaps the caller's work on the current value; the next
+*	pointer is only known once a link has been read, so one link
+*	ahead is as far as a list can prefetch.
+*
+*	Built with -DCONTAINER_STATS, each list also counts its
+*	operations, pool traffic, live bytes and scan lengths (see
+*	linkedListGetStats); otherwise the STAT macro compiles away.
 ************************************************************/
 #include "linkedList.h"
 #include <assert.h>
@@ -33,6 +83,43 @@
 #define FORMAT_SPECIFIER "%d"
 #endif
 
+#include "linkedListDump.h"
+
+// Number of links in the first block of a list's pool; each new
+// block doubles in size until it reaches the max.
+#ifndef LINK_POOL_MIN_BLOCK
+#define LINK_POOL_MIN_BLOCK 16
+#endif
+
+#ifndef LINK_POOL_MAX_BLOCK
+#define LINK_POOL_MAX_BLOCK 4096
+#endif
+
+#ifdef CONTAINER_STATS
+#define STAT(list, field, n) ((list)->stats.field += (n))
+#else
+#define STAT(list, field, n) ((void)0)
+#endif
+
+// Initial number of slots in a hash index; must be a power of two.
+#ifndef HASH_INDEX_MIN_CAPACITY
+#define HASH_INDEX_MIN_CAPACITY 16
+#endif
+
+// Hint that a link will be read soon; cursors issue it for the link
+// after the one they move to (NO_PREFETCH turns it off).
+#if defined(__GNUC__) && !defined(NO_PREFETCH)
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p) ((void)(p))
+#endif
+
+// Most tower levels in a skip list index; with one tower in four
+// levels this covers 4^16 links.
+#ifndef SKIP_MAX_LEVEL
+#define SKIP_MAX_LEVEL 16
+#endif
+
 // Double link
 struct Link
 {
@@ -41,14 +128,430 @@ struct Link
 	struct Link* prev;
 };
 
+// Contiguous block of links owned by a list's pool
+struct LinkBlock
+{
+	struct LinkBlock* next;
+	struct Link links[];
+};
+
+// Hash index slot; link is NULL if the slot was never used and
+// TOMBSTONE if its entry was erased.
+struct HashEntry
+{
+	TYPE value;
+	int count;			//occurrences of value (1 unless counted)
+	struct Link* link;
+};
+
+// Skip list tower over one link of a sorted list; level i of the
+// index chains the towers through next[i].
+struct SkipTower
+{
+	TYPE value;
+	struct Link* link;
+	int height;
+	struct SkipTower* next[];
+};
+
+static struct Link tombstoneLink;
+#define TOMBSTONE (&tombstoneLink)
+
 // Double linked list with front and back sentinels
 struct LinkedList
 {
 	struct Link* frontSentinel;
 	struct Link* backSentinel;
 	int size;
+	//Link pool.
+	struct LinkBlock* blocks;	//every block allocated by this list
+	struct Link* freeLinks;		//recycled links, chained through next
+	int freeCount;				//number of links on freeLinks
+	struct Link* carve;			//next unused link in the newest block
+	struct Link* carveEnd;		//one past the last link in that block
+	int blockSize;				//size of the next block to allocate
+	//Hash index (NULL unless created with linkedListCreateHashed).
+	struct HashEntry* table;
+	int tableCapacity;			//power of two
+	int tableFill;				//live entries plus tombstones
+	int counted;				//1 if made with linkedListCreateCounted
+	//Skip list index (NULL unless created with linkedListCreateSorted).
+	struct SkipTower* skipHead;	//SKIP_MAX_LEVEL high, over frontSentinel
+	int skipLevel;				//levels with at least one tower
+	unsigned int skipSeed;		//for tower heights
+#ifdef CONTAINER_STATS
+	struct LinkedListStats stats;
+#endif
 };
 
+/**
+	Allocates a new block of count links and makes it the block that
+	new links are carved from. Links that were never handed out from
+	the previous block are moved onto the free list so they are not lost.
+	param: 	list 	struct LinkedList ptr
+	param: 	count 	int
+	pre: 	list is not NULL, count > 0
+	post: 	new block is not NULL and is linked into list's blocks
+			carve/carveEnd span the new block
+ */
+static void addLinkBlock(struct LinkedList* list, int count)
+{
+	struct LinkBlock* block;
+	//Keep whatever is left of the current block.
+	while (list->carve != list->carveEnd) {
+		list->carve->next = list->freeLinks;
+		list->freeLinks = list->carve;
+		list->freeCount++;
+		list->carve++;
+	}
+	block = malloc(sizeof(struct LinkBlock) + count * sizeof(struct Link));
+	assert(block != 0);
+	STAT(list, bytesLive, (long)(sizeof(struct LinkBlock) + count * sizeof(struct Link)));
+	block->next = list->blocks;
+	list->blocks = block;
+	list->carve = block->links;
+	list->carveEnd = block->links + count;
+}
+
+/**
+	Takes a link from the list's pool: a recycled link if there is
+	one, otherwise the next unused link of the newest block (allocating
+	a bigger block when that one is used up).
+	param: 	list 	struct LinkedList ptr
+	pre: 	list is not NULL
+	ret: 	link (never NULL); its fields are uninitialized
+ */
+static struct Link* allocLink(struct LinkedList* list)
+{
+	struct Link* link;
+	STAT(list, nodesAllocated, 1);
+	if (list->freeLinks != NULL) {
+		link = list->freeLinks;
+		list->freeLinks = link->next;
+		list->freeCount--;
+		return link;
+	}
+	if (list->carve == list->carveEnd) {
+		addLinkBlock(list, list->blockSize);
+		if (list->blockSize < LINK_POOL_MAX_BLOCK) {
+			list->blockSize *= 2;
+		}
+	}
+	return list->carve++;
+}
+
+/**
+	Gives a link back to the list's pool so the next allocLink can
+	reuse it. The memory itself is only freed by linkedListDestroy.
+	param: 	list 	struct LinkedList ptr
+	param: 	link 	struct Link ptr
+	pre: 	list and link are not NULL, link came from list's pool
+	post: 	link is at the head of the free list
+ */
+static void freeLink(struct LinkedList* list, struct Link* link)
+{
+	STAT(list, nodesFreed, 1);
+	link->next = list->freeLinks;
+	list->freeLinks = link;
+	list->freeCount++;
+}
+
+/**
+	Returns the first slot to probe for the given value.
+	param: 	list 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	list has a hash index
+	ret: 	slot index in [0, tableCapacity)
+ */
+static int hashSlot(struct LinkedList* list, TYPE value)
+{
+	unsigned int h = HASH(value);
+	h ^= h >> 16;
+	return (int)(h & (unsigned int)(list->tableCapacity - 1));
+}
+
+/**
+	Stores an entry for link in the first free slot of its probe
+	sequence. Does not check the load factor.
+	param: 	list 	struct LinkedList ptr
+	param: 	link 	struct Link ptr
+	param: 	count 	int, occurrences the entry stands for
+	pre: 	list has a hash index with at least one empty slot
+	post: 	an entry for link is in the index
+ */
+static void hashPut(struct LinkedList* list, struct Link* link, int count)
+{
+	int mask = list->tableCapacity - 1;
+	int i = hashSlot(list, link->value);
+	while (list->table[i].link != NULL && list->table[i].link != TOMBSTONE) {
+		i = (i + 1) & mask;
+	}
+	if (list->table[i].link == NULL) {
+		list->tableFill++;
+	}
+	list->table[i].value = link->value;
+	list->table[i].count = count;
+	list->table[i].link = link;
+}
+
+/**
+	Rebuilds the hash index with the given number of slots from the
+	live entries of the current one (keeping their counts), dropping
+	all tombstones.
+	param: 	list 		struct LinkedList ptr
+	param: 	capacity 	int
+	pre: 	list is not NULL, capacity is a power of two > 2 * size
+	post: 	table holds the same entries and no tombstones
+ */
+static void hashRebuild(struct LinkedList* list, int capacity)
+{
+	STAT(list, bytesLive, (long)((capacity - list->tableCapacity) * sizeof(struct HashEntry)));
+	struct HashEntry* old = list->table;
+	int oldCapacity = list->tableCapacity;
+	list->table = (struct HashEntry*) calloc(capacity, sizeof(struct HashEntry));
+	assert(list->table != 0);
+	list->tableCapacity = capacity;
+	list->tableFill = 0;
+	for (int i = 0; i < oldCapacity; i++) {
+		if (old[i].link != NULL && old[i].link != TOMBSTONE) {
+			hashPut(list, old[i].link, old[i].count);
+		}
+	}
+	free(old);
+}
+
+/**
+	Adds an entry for a link that was just linked into the list,
+	growing (or clearing tombstones from) the index first if it
+	would be more than half full.
+	param: 	list 	struct LinkedList ptr
+	param: 	link 	struct Link ptr
+	pre: 	list has a hash index, link is in the list
+	post: 	an entry for link is in the index
+ */
+static void hashInsert(struct LinkedList* list, struct Link* link)
+{
+	if ((list->tableFill + 1) * 2 > list->tableCapacity) {
+		int capacity = list->tableCapacity;
+		if (list->size * 4 > capacity) {
+			capacity *= 2;
+		}
+		hashRebuild(list, capacity);
+	}
+	hashPut(list, link, 1);
+}
+
+/**
+	Returns the slot of an entry with the given value, or -1.
+	param: 	list 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	list has a hash index
+	ret: 	slot index or -1 if no link has the value
+ */
+static int hashFind(struct LinkedList* list, TYPE value)
+{
+	int mask = list->tableCapacity - 1;
+	int i = hashSlot(list, value);
+	while (list->table[i].link != NULL) {
+		if (list->table[i].link != TOMBSTONE && EQ(list->table[i].value, value)) {
+			return i;
+		}
+		i = (i + 1) & mask;
+	}
+	return -1;
+}
+
+/**
+	Returns the index entry of the given link.
+	param: 	list 	struct LinkedList ptr
+	param: 	link 	struct Link ptr
+	pre: 	list has a hash index that contains an entry for link
+	ret: 	entry for link
+ */
+static struct HashEntry* hashEntryOf(struct LinkedList* list, struct Link* link)
+{
+	int mask = list->tableCapacity - 1;
+	int i = hashSlot(list, link->value);
+	while (list->table[i].link != link) {
+		assert(list->table[i].link != NULL);
+		i = (i + 1) & mask;
+	}
+	return &list->table[i];
+}
+
+/**
+	Replaces the entry for the given link with a tombstone.
+	param: 	list 	struct LinkedList ptr
+	param: 	link 	struct Link ptr
+	pre: 	list has a hash index that contains an entry for link
+	post: 	no entry for link is in the index
+ */
+static void hashErase(struct LinkedList* list, struct Link* link)
+{
+	hashEntryOf(list, link)->link = TOMBSTONE;
+}
+
+/**
+	Returns the total count of the entries with the given value. All
+	of them are on the value's probe sequence before its first empty
+	slot.
+	param: 	list 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	list has a hash index
+	ret: 	occurrences of value
+ */
+static int hashCount(struct LinkedList* list, TYPE value)
+{
+	int mask = list->tableCapacity - 1;
+	int i = hashSlot(list, value);
+	int count = 0;
+	while (list->table[i].link != NULL) {
+		if (list->table[i].link != TOMBSTONE && EQ(list->table[i].value, value)) {
+			count += list->table[i].count;
+		}
+		i = (i + 1) & mask;
+	}
+	return count;
+}
+
+/**
+	Picks the height of a new link's tower: 0 (no tower) with
+	probability 3/4, then one more level with probability 1/4 each.
+	param: 	list 	struct LinkedList ptr
+	pre: 	list is not NULL
+	ret: 	height in [0, SKIP_MAX_LEVEL]
+ */
+static int skipRandomHeight(struct LinkedList* list)
+{
+	int height = 0;
+	while (height < SKIP_MAX_LEVEL) {
+		list->skipSeed = list->skipSeed * 1103515245u + 12345u;
+		if (((list->skipSeed >> 16) & 3) != 0) break;
+		height++;
+	}
+	return height;
+}
+
+/**
+	Walks the index down to the last tower whose value is LT the
+	given value, recording the last such tower of every level.
+	param: 	list 	struct LinkedList ptr
+	param: 	value 	TYPE
+	param: 	update 	struct SkipTower ptr array of SKIP_MAX_LEVEL, or NULL
+	pre: 	list has a skip list index
+	post: 	update[lvl] is the last tower LT value on level lvl,
+			for every lvl < skipLevel
+	ret: 	last tower LT value (the head if there is none)
+ */
+static struct SkipTower* skipDescend(struct LinkedList* list, TYPE value, struct SkipTower** update)
+{
+	struct SkipTower* tower = list->skipHead;
+	for (int lvl = list->skipLevel - 1; lvl >= 0; lvl--) {
+		while (tower->next[lvl] != NULL && LT(tower->next[lvl]->value, value)) {
+			STAT(list, nodesTraversed, 1);
+			tower = tower->next[lvl];
+		}
+		if (update != NULL) update[lvl] = tower;
+	}
+	return tower;
+}
+
+/**
+	Returns the last link whose value is LT the given value, so its
+	next is the first link with a value that is not.
+	param: 	list 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	list has a skip list index
+	ret: 	link (the front sentinel if no value is LT param value)
+ */
+static struct Link* skipFind(struct LinkedList* list, TYPE value)
+{
+	struct Link* link = skipDescend(list, value, NULL)->link;
+	while (link->next != list->backSentinel && LT(link->next->value, value)) {
+		STAT(list, nodesTraversed, 1);
+		link = link->next;
+	}
+	return link;
+}
+
+/**
+	Gives a link that was just linked into a sorted list a tower of
+	random height (most links get none).
+	param: 	list 	struct LinkedList ptr
+	param: 	link 	struct Link ptr
+	pre: 	list has a skip list index, link is in the list
+	post: 	link's tower, if any, is on every level below its height
+ */
+static void skipInsert(struct LinkedList* list, struct Link* link)
+{
+	int height = skipRandomHeight(list);
+	if (height == 0) return;
+	struct SkipTower* update[SKIP_MAX_LEVEL];
+	skipDescend(list, link->value, update);
+	for (int lvl = list->skipLevel; lvl < height; lvl++) {
+		update[lvl] = list->skipHead;
+	}
+	if (height > list->skipLevel) {
+		list->skipLevel = height;
+	}
+	struct SkipTower* tower = malloc(sizeof(struct SkipTower) + height * sizeof(struct SkipTower*));
+	assert(tower != 0);
+	STAT(list, bytesLive, (long)(sizeof(struct SkipTower) + height * sizeof(struct SkipTower*)));
+	tower->value = link->value;
+	tower->link = link;
+	tower->height = height;
+	for (int lvl = 0; lvl < height; lvl++) {
+		tower->next[lvl] = update[lvl]->next[lvl];
+		update[lvl]->next[lvl] = tower;
+	}
+}
+
+/**
+	Removes and frees the tower of a link that is about to be
+	removed from a sorted list, if it has one.
+	param: 	list 	struct LinkedList ptr
+	param: 	link 	struct Link ptr
+	pre: 	list has a skip list index, link is in the list
+	post: 	no tower is over link
+ */
+static void skipErase(struct LinkedList* list, struct Link* link)
+{
+	struct SkipTower* update[SKIP_MAX_LEVEL];
+	struct SkipTower* tower = skipDescend(list, link->value, update)->next[0];
+	//Towers of equal values may be in any order; look for link's own.
+	while (tower != NULL && tower->link != link && !LT(link->value, tower->value)) {
+		tower = tower->next[0];
+	}
+	if (tower == NULL || tower->link != link) return;
+	for (int lvl = 0; lvl < tower->height; lvl++) {
+		struct SkipTower* prev = update[lvl];
+		while (prev->next[lvl] != tower) {
+			prev = prev->next[lvl];
+		}
+		prev->next[lvl] = tower->next[lvl];
+	}
+	while (list->skipLevel > 0 && list->skipHead->next[list->skipLevel - 1] == NULL) {
+		list->skipLevel--;
+	}
+	STAT(list, bytesLive, -(long)(sizeof(struct SkipTower) + tower->height * sizeof(struct SkipTower*)));
+	free(tower);
+}
+
+/**
+	Asserts that a link just linked into a sorted list is not LT its
+	prev and that its next is not LT it.
+	param: 	list 	struct LinkedList ptr
+	param: 	link 	struct Link ptr
+	pre: 	link is in list
+ */
+static void assertSortedAround(struct LinkedList* list, struct Link* link)
+{
+	assert(link->prev == list->frontSentinel || !LT(link->value, link->prev->value));
+	assert(link->next == list->backSentinel || !LT(link->next->value, link->value));
+	(void)list;
+	(void)link;
+}
+
 /**
   	Allocates the list's sentinel and sets the size to 0.
   	The sentinels' next and prev should point to eachother or NULL
@@ -63,11 +566,29 @@ struct LinkedList
 			list size is 0
  */
 static void init(struct LinkedList* list) {
+#ifdef CONTAINER_STATS
+	struct LinkedListStats zero = {0};
+	list->stats = zero;
+	list->stats.bytesLive = sizeof(struct LinkedList);
+#endif
+	//Start with an empty pool.
+	list->blocks = NULL;
+	list->freeLinks = NULL;
+	list->freeCount = 0;
+	list->carve = list->carveEnd = NULL;
+	list->blockSize = LINK_POOL_MIN_BLOCK;
+	//No hash index.
+	list->table = NULL;
+	list->tableCapacity = 0;
+	list->tableFill = 0;
+	list->counted = 0;
+	//No skip list index.
+	list->skipHead = NULL;
+	list->skipLevel = 0;
+	list->skipSeed = 1;
 	//Create front and back sentinels.
-	list->frontSentinel = (struct Link*) malloc(sizeof(struct Link));
-	assert(list->frontSentinel != 0);
-	list->backSentinel = (struct Link*) malloc(sizeof(struct Link));
-	assert(list->backSentinel != 0);
+	list->frontSentinel = allocLink(list);
+	list->backSentinel = allocLink(list);
 	//Set the the pointers in the sentinels.
 	list->frontSentinel->next = list->backSentinel;
 	list->frontSentinel->prev = NULL;
@@ -91,8 +612,7 @@ static void init(struct LinkedList* list) {
 static void addLinkBefore(struct LinkedList* list, struct Link* link, TYPE value)
 {
 	//Create new link to be added to list.
-	struct Link* newLink = (struct Link*) malloc(sizeof(struct Link));
-	assert(newLink != 0);
+	struct Link* newLink = allocLink(list);
 	newLink->value = value;
 	//Assign memory values to add link before the given link.
 	newLink->prev = link->prev;
@@ -101,6 +621,13 @@ static void addLinkBefore(struct LinkedList* list, struct Link* link, TYPE value
 	link->prev = newLink;
 	//Increment the list size.
 	list->size++;
+	if (list->table != NULL) {
+		hashInsert(list, newLink);
+	}
+	if (list->skipHead != NULL) {
+		assertSortedAround(list, newLink);
+		skipInsert(list, newLink);
+	}
 }
 
 /**
@@ -110,7 +637,7 @@ static void addLinkBefore(struct LinkedList* list, struct Link* link, TYPE value
  	param:	link 	struct Link ptr*
 	pre: 	list and link are not NULL
 	post: 	param link is removed from param list
-			memory allocated to link is freed
+			link is returned to the list's pool
 			list size is decremented by 1
  */
 static void removeLink(struct LinkedList* list, struct Link* link)
@@ -121,14 +648,142 @@ static void removeLink(struct LinkedList* list, struct Link* link)
 
 			link->prev->next = link->next;
 			link->next->prev = link->prev; //It says the seg. fault occurs here.
-			//free the link address.
-			free(link);
+			if (list->table != NULL) {
+				hashErase(list, link);
+			}
+			if (list->skipHead != NULL) {
+				skipErase(list, link);
+			}
+			//Recycle the link.
+			freeLink(list, link);
 			//Deincrement the list size.
 			list->size--;
 		}
 		 //still need to decrement deque size
 }
 
+/**
+	Adds entries for a run of n links that were just linked into the
+	list. If they would leave the index more than half full it is
+	rebuilt once, big enough for the whole run.
+	param: 	list 	struct LinkedList ptr
+	param: 	first 	struct Link ptr, first link of the run
+	param: 	n 		int
+	pre: 	list has a hash index, the run is in the list
+	post: 	an entry for each link of the run is in the index
+ */
+static void hashInsertRun(struct LinkedList* list, struct Link* first, int n)
+{
+	if ((list->tableFill + n) * 2 > list->tableCapacity) {
+		int capacity = list->tableCapacity;
+		while (list->size * 4 > capacity) {
+			capacity *= 2;
+		}
+		hashRebuild(list, capacity);
+	}
+	for (int i = 0; i < n; i++) {
+		hashPut(list, first, 1);
+		first = first->next;
+	}
+}
+
+/**
+	Adds n new links with the given values before the given link in
+	one pass: the pool is topped up once, the links are chained to
+	each other and the run is spliced in with two pointer writes.
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	param: 	reverse int (1 = values[n - 1] is linked first)
+	pre: 	list and link are not NULL, values holds n values
+	post: 	the run of n links is before param link
+			list size is incremented by n
+ */
+static void addLinksBefore(struct LinkedList* list, struct Link* link,
+	const TYPE* values, int n, int reverse)
+{
+	linkedListReserve(list, n);
+	struct Link* before = link->prev;
+	struct Link* prev = before;
+	for (int i = 0; i < n; i++) {
+		struct Link* newLink = allocLink(list);
+		newLink->value = values[reverse ? n - 1 - i : i];
+		newLink->prev = prev;
+		prev->next = newLink;
+		prev = newLink;
+	}
+	prev->next = link;
+	link->prev = prev;
+	list->size += n;
+	if (list->table != NULL) {
+		hashInsertRun(list, before->next, n);
+	}
+	if (list->skipHead != NULL) {
+		for (struct Link* added = before->next; added != link; added = added->next) {
+			assertSortedAround(list, added);
+			skipInsert(list, added);
+		}
+	}
+}
+
+/**
+	Adds count occurrences of value to a counted list: bumps the count
+	of value's link if it has one, otherwise links a new link in
+	before the given link.
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr, where a new link would go
+	param: 	value 	TYPE
+	param: 	count 	int
+	pre: 	list is counted, link is in list, count > 0
+	post: 	value's entry counts count more occurrences
+ */
+static void addCounted(struct LinkedList* list, struct Link* link, TYPE value, int count)
+{
+	int i = hashFind(list, value);
+	if (i != -1) {
+		list->table[i].count += count;
+		return;
+	}
+	addLinkBefore(list, link, value);
+	hashEntryOf(list, link->prev)->count = count;
+}
+
+/**
+	Adds a value to a sorted list before the first value that is not
+	LT it, so deque adds and cursor inserts cannot break the order.
+	param: 	list 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	list has a skip list index
+	post: 	a link with value is in its sorted place
+ */
+static void addSorted(struct LinkedList* list, TYPE value)
+{
+	addLinkBefore(list, skipFind(list, value)->next, value);
+}
+
+/**
+	Removes one occurrence of the given link's value: in a counted
+	list the link stays until its count drops to 0.
+	param: 	list 	struct LinkedList ptr
+	param:	link 	struct Link ptr
+	pre: 	list is not NULL, link is in list
+	post: 	one occurrence is removed (call to removeLink for the last)
+	ret: 	1 if the link was removed, 0 if only its count went down
+ */
+static int removeOccurrence(struct LinkedList* list, struct Link* link)
+{
+	if (list->counted) {
+		struct HashEntry* entry = hashEntryOf(list, link);
+		if (entry->count > 1) {
+			entry->count--;
+			return 0;
+		}
+	}
+	removeLink(list, link);
+	return 1;
+}
+
 /**
 	Allocates and initializes a list.
 	pre: 	none
@@ -143,9 +798,68 @@ struct LinkedList* linkedListCreate()
 	return list;
 }
 
+/**
+	Allocates and initializes a list that keeps a hash index of its
+	values, for O(1) expected bag contains/remove.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+			list init (call to init func)
+			list has an empty hash index
+	return: list
+ */
+struct LinkedList* linkedListCreateHashed()
+{
+	struct LinkedList* list = linkedListCreate();
+	hashRebuild(list, HASH_INDEX_MIN_CAPACITY);
+	return list;
+}
+
+/**
+	Allocates and initializes a counted list: a hashed list with one
+	link per distinct value whose index entry counts its occurrences,
+	so adding a duplicate costs a counter increment and no link.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+			list has an empty hash index and counts duplicates
+	return: list
+ */
+struct LinkedList* linkedListCreateCounted()
+{
+	struct LinkedList* list = linkedListCreateHashed();
+	list->counted = 1;
+	return list;
+}
+
+/**
+	Allocates and initializes a list that keeps its values in LT
+	order with a skip list index, for O(log n) expected bag add,
+	contains and remove and for range queries. Deque adds, bulk adds
+	and cursor inserts also put each value in its sorted place.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+			list init (call to init func)
+			list has an empty skip list index
+	return: list
+ */
+struct LinkedList* linkedListCreateSorted()
+{
+	struct LinkedList* list = linkedListCreate();
+	size_t bytes = sizeof(struct SkipTower) + SKIP_MAX_LEVEL * sizeof(struct SkipTower*);
+	list->skipHead = malloc(bytes);
+	assert(list->skipHead != 0);
+	STAT(list, bytesLive, (long)bytes);
+	list->skipHead->link = list->frontSentinel;
+	list->skipHead->height = SKIP_MAX_LEVEL;
+	for (int lvl = 0; lvl < SKIP_MAX_LEVEL; lvl++) {
+		list->skipHead->next[lvl] = NULL;
+	}
+	return list;
+}
+
 /**
 	Deallocates every link in the list including the sentinels,
-	and frees the list itself.
+	and frees the list itself. Since every link lives in one of the
+	pool's blocks, this frees the blocks rather than walking the links.
 	param:	list 	struct LinkedList ptr
 	pre: 	list is not NULL
 	post: 	memory allocated to each link is freed
@@ -155,27 +869,64 @@ struct LinkedList* linkedListCreate()
 void linkedListDestroy(struct LinkedList* list)
 {
 	assert(list != NULL);
-
-	while (linkedListIsEmpty(list) == 0) {
-		linkedListRemoveFront(list);
+	struct LinkBlock* block = list->blocks;
+	while (block != NULL) {
+		struct LinkBlock* next = block->next;
+		free(block);
+		block = next;
+	}
+	free(list->table);
+	if (list->skipHead != NULL) {
+		struct SkipTower* tower = list->skipHead;
+		while (tower != NULL) {
+			struct SkipTower* next = tower->next[0];
+			free(tower);
+			tower = next;
+		}
 	}
-	free(list->frontSentinel);
-	free(list->backSentinel);
 	free(list);
 	list = NULL;
 }
 
+/**
+	Makes sure the list can hold n more links without allocating,
+	e.g. before a burst of adds. At most one block is allocated.
+	param:	list 	struct LinkedList ptr
+	param:	n 		int
+	pre: 	list is not NULL, n >= 0
+	post: 	at least n links are available in the list's pool
+ */
+void linkedListReserve(struct LinkedList* list, int n)
+{
+	assert(list != NULL && n >= 0);
+	int available = list->freeCount + (int)(list->carveEnd - list->carve);
+	if (available < n) {
+		addLinkBlock(list, n - available);
+	}
+}
+
 /**
 	Adds a new link with the given value to the front of the deque.
 	param: 	deque 	struct LinkedList ptr
 	param: 	value 	TYPE
 	pre: 	deque is not NULL
 	post: 	link is created w/ param value stored before current first link
-			(call to addLinkBefore)
+			(call to addLinkBefore); in a counted list, if value is
+			already there its count goes up and it stays where it is;
+			in a sorted list it goes in its sorted place instead
  */
 void linkedListAddFront(struct LinkedList* deque, TYPE value)
 {
 	assert(deque != NULL);
+	STAT(deque, addFront, 1);
+	if (deque->counted) {
+		addCounted(deque, deque->frontSentinel->next, value, 1);
+		return;
+	}
+	if (deque->skipHead != NULL) {
+		addSorted(deque, value);
+		return;
+	}
 	addLinkBefore(deque, deque->frontSentinel->next, value);
 	/* FIXME: You will write this function */
 }
@@ -186,11 +937,22 @@ void linkedListAddFront(struct LinkedList* deque, TYPE value)
 	param: 	value 	TYPE
 	pre: 	deque is not NULL
 	post: 	link is created with given value before current last link
-			(call to addLinkBefore)
+			(call to addLinkBefore); in a counted list, if value is
+			already there its count goes up and it stays where it is;
+			in a sorted list it goes in its sorted place instead
  */
 void linkedListAddBack(struct LinkedList* deque, TYPE value)
 {
 	assert(deque != NULL);
+	STAT(deque, addBack, 1);
+	if (deque->counted) {
+		addCounted(deque, deque->backSentinel, value, 1);
+		return;
+	}
+	if (deque->skipHead != NULL) {
+		addSorted(deque, value);
+		return;
+	}
 	addLinkBefore(deque, deque->backSentinel, value);
 	/* FIXME: You will write this function */
 }
@@ -205,6 +967,7 @@ void linkedListAddBack(struct LinkedList* deque, TYPE value)
  */
 TYPE linkedListFront(struct LinkedList* deque)
 {
+	STAT(deque, front, 1);
 	return(deque->frontSentinel->next->value);
 }
 
@@ -218,6 +981,7 @@ TYPE linkedListFront(struct LinkedList* deque)
  */
 TYPE linkedListBack(struct LinkedList* deque)
 {
+	STAT(deque, back, 1);
 	return(deque->backSentinel->prev->value);
 }
 
@@ -226,12 +990,14 @@ TYPE linkedListBack(struct LinkedList* deque)
 	param: 	deque 	struct LinkedList ptr
 	pre:	deque is not NULL
 	pre:	deque is not empty
-	post:	first link is removed and freed (call to removeLink)
+	post:	first link is removed and freed (call to removeOccurrence;
+			in a counted list only one occurrence is removed)
  */
 void linkedListRemoveFront(struct LinkedList* deque)
 {
 	assert(deque != NULL && deque->size != 0);
-	removeLink(deque, deque->frontSentinel->next);
+	STAT(deque, removeFront, 1);
+	removeOccurrence(deque, deque->frontSentinel->next);
 	//Does the assert do the same thing as nesting it in an if loop? it checks if the deque is properly allocated, if the statement in the parentheses is false it will throw an error and stop the program
 	// if(deque->frontSentinel->next != deque->backSentinel){
 	// 	struct Link* temp = deque->frontSentinel->next;
@@ -249,13 +1015,15 @@ void linkedListRemoveFront(struct LinkedList* deque)
 	param: 	deque 	struct LinkedList ptr
 	pre:	deque is not NULL
 	pre:	deque is not empty
-	post:	last link is removed and freed (call to removeLink)
+	post:	last link is removed and freed (call to removeOccurrence;
+			in a counted list only one occurrence is removed)
  */
 void linkedListRemoveBack(struct LinkedList* deque)
 {
 	//Create a temp pointer to hold former back Link address.
 	assert(deque != 0);
-	removeLink(deque, deque->backSentinel->prev);
+	STAT(deque, removeBack, 1);
+	removeOccurrence(deque, deque->backSentinel->prev);
 }
 
 /**
@@ -273,29 +1041,343 @@ int linkedListIsEmpty(struct LinkedList* deque)
 }
 
 /**
-	Prints the values of the links in the deque from front to back.
+	Adds every value of the deque to buffer, from front to back (in a
+	counted list, each as often as it occurs).
+	param:	deque	struct LinkedList ptr
+	param:	buffer	struct DequeDump ptr
+	pre:	deque is not NULL, buffer was opened
+ */
+static void dumpValues(struct LinkedList* deque, struct DequeDump* buffer)
+{
+	for (struct Link* link = deque->frontSentinel->next; link != deque->backSentinel;
+		link = link->next) {
+		int count = deque->counted ? hashEntryOf(deque, link)->count : 1;
+		for (int i = 0; i < count; i++) {
+			dumpValue(buffer, link->value);
+		}
+	}
+}
+
+/**
+	Writes the values in the deque from front to back to out.
+	param:	deque	struct LinkedList ptr
+	param:	out		FILE ptr
+	param:	mode	LINKED_LIST_DUMP_TEXT or LINKED_LIST_DUMP_BINARY
+	pre:	deque and out are not NULL
+	ret:	0 if every write succeeded; otherwise, -1
+ */
+int linkedListDump(struct LinkedList* deque, FILE* out, int mode)
+{
+	assert(deque != NULL && out != NULL);
+	struct DequeDump buffer;
+	dequeDumpOpen(&buffer, out, -1, mode);
+	dumpValues(deque, &buffer);
+	return dequeDumpClose(&buffer);
+}
+
+/**
+	Writes the values in the deque from front to back to the file
+	descriptor fd.
+	param:	deque	struct LinkedList ptr
+	param:	fd		int
+	param:	mode	LINKED_LIST_DUMP_TEXT or LINKED_LIST_DUMP_BINARY
+	pre:	deque is not NULL, fd is open for writing
+	ret:	0 if every write succeeded; otherwise, -1 (errno is set)
+ */
+int linkedListDumpFd(struct LinkedList* deque, int fd, int mode)
+{
+	assert(deque != NULL);
+	struct DequeDump buffer;
+	dequeDumpOpen(&buffer, NULL, fd, mode);
+	dumpValues(deque, &buffer);
+	return dequeDumpClose(&buffer);
+}
+
+/**
+	Prints the values in the deque from front to back, one per line.
 	param:	deque	struct LinkedList ptr
 	pre:	deque is not NULL
-	post:	none
-	ret:	outputs to the console the values of the links from front
-			to back; if empty, prints msg that is empty
+	ret:	outputs to the console the values from front to back
  */
 void linkedListPrint(struct LinkedList* deque)
 {
-	assert(deque != NULL);
-	struct Link* temp = deque->frontSentinel->next;
-	while(temp != deque->backSentinel){
-		printf("%d \n", temp->value);
-		temp = temp->next;
+	linkedListDump(deque, stdout, LINKED_LIST_DUMP_TEXT);
+}
+
+/**
+	Allocates a list holding the given values, values[0] at the front.
+	All links are carved from one block.
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	pre: 	values is not NULL unless n is 0, n >= 0
+	post: 	memory allocated for new struct LinkedList ptr
+			list holds the n values in order
+	return: list
+ */
+struct LinkedList* linkedListCreateFromArray(const TYPE* values, int n)
+{
+	struct LinkedList* list = linkedListCreate();
+	linkedListAddBackN(list, values, n);
+	return list;
+}
+
+/**
+	Adds n values to the back of the deque, in order, so values[n - 1]
+	ends up at the back (same result as n calls to linkedListAddBack).
+	param: 	deque 	struct LinkedList ptr
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	pre:	values is not NULL unless n is 0
+	post: 	n links are added after the current last link
+			(call to addLinksBefore); in a sorted list each one goes
+			in its sorted place instead
+ */
+void linkedListAddBackN(struct LinkedList* deque, const TYPE* values, int n)
+{
+	assert(deque != NULL && n >= 0);
+	assert(values != NULL || n == 0);
+	if (n == 0) return;
+	STAT(deque, addBack, n);
+	if (deque->counted) {
+		for (int i = 0; i < n; i++) {
+			addCounted(deque, deque->backSentinel, values[i], 1);
+		}
+		return;
 	}
-	/* FIXME: You will write this function */
+	if (deque->skipHead != NULL) {
+		linkedListReserve(deque, n);
+		for (int i = 0; i < n; i++) {
+			addSorted(deque, values[i]);
+		}
+		return;
+	}
+	addLinksBefore(deque, deque->backSentinel, values, n, 0);
 }
 
+/**
+	Adds n values to the front of the deque, one after the other, so
+	values[n - 1] ends up at the front (same result as n calls to
+	linkedListAddFront).
+	param: 	deque 	struct LinkedList ptr
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	pre:	values is not NULL unless n is 0
+	post: 	n links are added before the current first link
+			(call to addLinksBefore); in a sorted list each one goes
+			in its sorted place instead
+ */
+void linkedListAddFrontN(struct LinkedList* deque, const TYPE* values, int n)
+{
+	assert(deque != NULL && n >= 0);
+	assert(values != NULL || n == 0);
+	if (n == 0) return;
+	STAT(deque, addFront, n);
+	if (deque->counted) {
+		for (int i = 0; i < n; i++) {
+			addCounted(deque, deque->frontSentinel->next, values[i], 1);
+		}
+		return;
+	}
+	if (deque->skipHead != NULL) {
+		linkedListReserve(deque, n);
+		for (int i = 0; i < n; i++) {
+			addSorted(deque, values[i]);
+		}
+		return;
+	}
+	addLinksBefore(deque, deque->frontSentinel->next, values, n, 1);
+}
 
+/**
+	Removes up to n links from the front of the deque in one pass and
+	copies their values out, front value first.
+	param: 	deque 	struct LinkedList ptr
+	param: 	out 	TYPE ptr, room for n values (or NULL to drop them)
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	post: 	the first min(n, size) links are returned to the pool
+			(in a counted list, the first n occurrences are removed)
+	ret: 	number of values removed
+ */
+int linkedListRemoveFrontN(struct LinkedList* deque, TYPE* out, int n)
+{
+	assert(deque != NULL && n >= 0);
+	if (deque->counted) {
+		int removed = 0;
+		while (removed < n && deque->size > 0) {
+			if (out != NULL) out[removed] = deque->frontSentinel->next->value;
+			removeOccurrence(deque, deque->frontSentinel->next);
+			removed++;
+		}
+		STAT(deque, removeFront, removed);
+		return removed;
+	}
+	if (n > deque->size) n = deque->size;
+	STAT(deque, removeFront, n);
+	struct Link* link = deque->frontSentinel->next;
+	for (int i = 0; i < n; i++) {
+		struct Link* next = link->next;
+		if (out != NULL) out[i] = link->value;
+		if (deque->table != NULL) {
+			hashErase(deque, link);
+		}
+		if (deque->skipHead != NULL) {
+			skipErase(deque, link);
+		}
+		freeLink(deque, link);
+		link = next;
+	}
+	deque->frontSentinel->next = link;
+	link->prev = deque->frontSentinel;
+	deque->size -= n;
+	return n;
+}
 
+/**
+	Removes up to n links from the back of the deque in one pass and
+	copies their values out, back value first.
+	param: 	deque 	struct LinkedList ptr
+	param: 	out 	TYPE ptr, room for n values (or NULL to drop them)
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	post: 	the last min(n, size) links are returned to the pool
+			(in a counted list, the last n occurrences are removed)
+	ret: 	number of values removed
+ */
+int linkedListRemoveBackN(struct LinkedList* deque, TYPE* out, int n)
+{
+	assert(deque != NULL && n >= 0);
+	if (deque->counted) {
+		int removed = 0;
+		while (removed < n && deque->size > 0) {
+			if (out != NULL) out[removed] = deque->backSentinel->prev->value;
+			removeOccurrence(deque, deque->backSentinel->prev);
+			removed++;
+		}
+		STAT(deque, removeBack, removed);
+		return removed;
+	}
+	if (n > deque->size) n = deque->size;
+	STAT(deque, removeBack, n);
+	struct Link* link = deque->backSentinel->prev;
+	for (int i = 0; i < n; i++) {
+		struct Link* prev = link->prev;
+		if (out != NULL) out[i] = link->value;
+		if (deque->table != NULL) {
+			hashErase(deque, link);
+		}
+		if (deque->skipHead != NULL) {
+			skipErase(deque, link);
+		}
+		freeLink(deque, link);
+		link = prev;
+	}
+	deque->backSentinel->prev = link;
+	link->next = deque->backSentinel;
+	deque->size -= n;
+	return n;
+}
 
+/**
+	Sorts a NULL-terminated chain of links (chained through next
+	only) by LT with a bottom-up merge sort: each pass merges
+	neighbouring sorted runs of insize links into runs of twice
+	that, until one pass does a single merge. Ties take the link
+	from the left run, so the sort is stable.
+	param: 	list 	struct LinkedList ptr (for stats)
+	param: 	head 	struct Link ptr, first link of the chain
+	pre: 	head is not NULL
+	post: 	the chain's links are relinked in LT order through next;
+			their prev pointers are not updated
+	ret: 	first link of the sorted chain
+ */
+static struct Link* mergeSortChain(struct LinkedList* list, struct Link* head)
+{
+	(void)list;
+	for (int insize = 1; ; insize *= 2) {
+		struct Link* p = head;
+		struct Link* tail = NULL;
+		int merges = 0;
+		head = NULL;
+		while (p != NULL) {
+			//Right run starts insize links after p.
+			struct Link* q = p;
+			int psize = 0;
+			merges++;
+			while (psize < insize && q != NULL) {
+				psize++;
+				q = q->next;
+			}
+			int qsize = insize;
+			//Merge the two runs onto tail.
+			while (psize > 0 || (qsize > 0 && q != NULL)) {
+				struct Link* e;
+				if (psize == 0 || (qsize > 0 && q != NULL && LT(q->value, p->value))) {
+					e = q;
+					q = q->next;
+					qsize--;
+				}
+				else {
+					e = p;
+					p = p->next;
+					psize--;
+				}
+				STAT(list, nodesTraversed, 1);
+				if (tail != NULL) tail->next = e;
+				else head = e;
+				tail = e;
+			}
+			p = q;
+		}
+		tail->next = NULL;
+		if (merges <= 1) return head;
+	}
+}
 
+/**
+	Sorts the list by LT in O(n log n) without allocating: the links
+	are relinked in place (call to mergeSortChain), so no value is
+	copied and the hash index, which points at links, stays valid.
+	The sort is stable. A sorted list is already in order.
+	param: 	list 	struct LinkedList ptr
+	pre: 	list is not NULL
+	post: 	links are in LT order from front to back; equal values
+			keep their relative order
+ */
+void linkedListSort(struct LinkedList* list)
+{
+	assert(list != NULL);
+	if (list->size < 2 || list->skipHead != NULL) return;
+	list->backSentinel->prev->next = NULL;
+	struct Link* link = mergeSortChain(list, list->frontSentinel->next);
+	//Restore the prev pointers and the sentinels.
+	struct Link* prev = list->frontSentinel;
+	prev->next = link;
+	while (link != NULL) {
+		link->prev = prev;
+		prev = link;
+		link = link->next;
+	}
+	prev->next = list->backSentinel;
+	list->backSentinel->prev = prev;
+}
 
+#ifdef CONTAINER_STATS
+/**
+	Copies the list's operation counters into stats.
+	param:	list	struct LinkedList ptr
+	param:	stats	struct LinkedListStats ptr
+	pre:	list and stats are not NULL
+	post:	stats holds the counts since the list was created
+ */
+void linkedListGetStats(struct LinkedList* list, struct LinkedListStats* stats)
+{
+	assert(list != NULL && stats != NULL);
+	*stats = list->stats;
+}
+#endif
 
 ////////////////BAG/////////////////BAG///////////BAG////////////////
 /**
@@ -307,10 +1389,21 @@ void linkedListPrint(struct LinkedList* deque)
 			(call to addLinkBefore)
 			Note that bag doesn't specify where new link should be added;
 			can be anywhere in bag according to its ADT.
+			In a sorted list the link goes before the first value that
+			is not LT it instead.
  */
 void linkedListAdd(struct LinkedList* bag, TYPE value)
 {
 	assert(bag != NULL);
+	STAT(bag, add, 1);
+	if (bag->counted) {
+		addCounted(bag, bag->frontSentinel->next, value, 1);
+		return;
+	}
+	if (bag->skipHead != NULL) {
+		addSorted(bag, value);
+		return;
+	}
 	addLinkBefore(bag, bag->frontSentinel->next, value);
 }
 
@@ -325,9 +1418,18 @@ void linkedListAdd(struct LinkedList* bag, TYPE value)
 int linkedListContains(struct LinkedList* bag, TYPE value)
 {
 	assert(bag != NULL);
+	STAT(bag, contains, 1);
+	if (bag->table != NULL) {
+		return hashFind(bag, value) != -1;
+	}
+	if (bag->skipHead != NULL) {
+		struct Link* link = skipFind(bag, value)->next;
+		return link != bag->backSentinel && EQ(link->value, value);
+	}
 	struct Link *tmp = bag->frontSentinel->next;
 	while(tmp->next != NULL){
-		if(tmp->value == value) return 1;
+		STAT(bag, nodesTraversed, 1);
+		if(EQ(tmp->value, value)) return 1;
 		tmp = tmp->next;
 	}
 	return 0;
@@ -340,23 +1442,44 @@ int linkedListContains(struct LinkedList* bag, TYPE value)
 	pre: 	bag is not NULL
 	post:	if link with given value found, link is removed
 			(call to removeLink)
+			With a hash index, the link removed is whichever one the
+			index finds first, not necessarily the first in the list.
  */
 void linkedListRemove(struct LinkedList* bag, TYPE value)
 {
 	//Check that we're working with a proper bag.
 	assert(bag != NULL);
 	assert(!linkedListIsEmpty(bag));
+	STAT(bag, remove, 1);
 	//Find the link to remove.
-	struct Link *tmp = bag->frontSentinel->next;
 	struct Link *linkR = NULL;
-	while(tmp->next != NULL){
-		if(tmp->value == value){
-			linkR = tmp;
+	if (bag->table != NULL) {
+		int i = hashFind(bag, value);
+		if (i != -1) {
+			linkR = bag->table[i].link;
+		}
+	}
+	else if (bag->skipHead != NULL) {
+		struct Link* link = skipFind(bag, value)->next;
+		if (link != bag->backSentinel && EQ(link->value, value)) {
+			linkR = link;
 		}
-		tmp = tmp->next;
 	}
-	//Remove bag link.
-	removeLink(bag, linkR);
+	else {
+		struct Link *tmp = bag->frontSentinel->next;
+		while(tmp->next != NULL){
+			STAT(bag, nodesTraversed, 1);
+			if(EQ(tmp->value, value)){
+				linkR = tmp;
+				break;
+			}
+			tmp = tmp->next;
+		}
+	}
+	//Remove bag link (one occurrence of it in a counted bag).
+	if (linkR != NULL) {
+		removeOccurrence(bag, linkR);
+	}
 	// struct Link *previous = bag->frontSentinel;
 	// struct Link *current = bag->frontSentinel->next;
 	// while (current != NULL)
@@ -370,3 +1493,266 @@ void linkedListRemove(struct LinkedList* bag, TYPE value)
 	// 	current = current->next;
 	// }
 }
+
+/**
+	Returns the number of times the value is in the bag. O(1) expected
+	in a hashed or counted bag, O(log n + count) in a sorted one and
+	a full scan otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not NULL
+	post:	none
+	ret:	occurrences of value
+ */
+int linkedListCount(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != NULL);
+	STAT(bag, contains, 1);
+	if (bag->table != NULL) {
+		return hashCount(bag, value);
+	}
+	int count = 0;
+	struct Link* link = bag->skipHead != NULL ? skipFind(bag, value)->next : bag->frontSentinel->next;
+	while (link != bag->backSentinel) {
+		STAT(bag, nodesTraversed, 1);
+		if (EQ(link->value, value)) {
+			count++;
+		}
+		else if (bag->skipHead != NULL) {
+			break;
+		}
+		link = link->next;
+	}
+	return count;
+}
+
+/**
+	Adds n occurrences of the value to the bag: one count increment
+	in a counted bag, n links otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	param: 	n 		int
+	pre: 	bag is not NULL, n >= 0
+	post: 	value is in the bag n more times
+ */
+void linkedListAddMany(struct LinkedList* bag, TYPE value, int n)
+{
+	assert(bag != NULL && n >= 0);
+	if (n == 0) return;
+	STAT(bag, add, n);
+	if (bag->counted) {
+		addCounted(bag, bag->frontSentinel->next, value, n);
+		return;
+	}
+	linkedListReserve(bag, n);
+	struct Link* link = bag->skipHead != NULL ? skipFind(bag, value)->next : bag->frontSentinel->next;
+	for (int i = 0; i < n; i++) {
+		addLinkBefore(bag, link, value);
+	}
+}
+
+/**
+	Returns the first link of the bag that could hold a value in
+	[lo, hi): the first value not LT lo in a sorted list, otherwise
+	the first link.
+	param:	bag		struct LinkedList ptr
+	param: 	lo 		TYPE
+	pre: 	bag is not NULL
+	ret:	link (the back sentinel if there is none)
+ */
+static struct Link* rangeStart(struct LinkedList* bag, TYPE lo)
+{
+	if (bag->skipHead != NULL) {
+		return skipFind(bag, lo)->next;
+	}
+	return bag->frontSentinel->next;
+}
+
+/**
+	Returns the number of values v in the bag with lo <= v < hi
+	(by LT). O(log n + k) in a sorted list, a full scan otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	lo 		TYPE
+	param: 	hi 		TYPE
+	pre: 	bag is not NULL
+	post:	none
+	ret:	number of values in [lo, hi)
+ */
+int linkedListCountRange(struct LinkedList* bag, TYPE lo, TYPE hi)
+{
+	assert(bag != NULL);
+	int count = 0;
+	for (struct Link* link = rangeStart(bag, lo); link != bag->backSentinel; link = link->next) {
+		STAT(bag, nodesTraversed, 1);
+		if (!LT(link->value, hi)) {
+			if (bag->skipHead != NULL) break;
+			continue;
+		}
+		if (!LT(link->value, lo)) count++;
+	}
+	return count;
+}
+
+/**
+	Calls visit(v, arg) for every value v in the bag with lo <= v < hi
+	(by LT), in list order (ascending in a sorted list). O(log n + k)
+	in a sorted list, a full scan otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	lo 		TYPE
+	param: 	hi 		TYPE
+	param: 	visit 	function called with each value and arg
+	param: 	arg 	void ptr passed through to visit
+	pre: 	bag and visit are not NULL
+	pre:	visit does not change the bag
+ */
+void linkedListForEachRange(struct LinkedList* bag, TYPE lo, TYPE hi,
+	void (*visit)(TYPE value, void* arg), void* arg)
+{
+	assert(bag != NULL && visit != NULL);
+	for (struct Link* link = rangeStart(bag, lo); link != bag->backSentinel; link = link->next) {
+		STAT(bag, nodesTraversed, 1);
+		if (!LT(link->value, hi)) {
+			if (bag->skipHead != NULL) break;
+			continue;
+		}
+		if (!LT(link->value, lo)) visit(link->value, arg);
+	}
+}
+
+////////////////CURSOR//////////////CURSOR////////CURSOR/////////////
+/**
+	Puts the cursor on the front value of the list (past the back if
+	the list is empty).
+	param:	list	struct LinkedList ptr
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	list and cursor are not NULL
+	post:	cursor is on the first link
+ */
+void linkedListCursorFront(struct LinkedList* list, struct LinkedListCursor* cursor)
+{
+	assert(list != NULL && cursor != NULL);
+	struct Link* link = list->frontSentinel->next;
+	PREFETCH(link->next);
+	cursor->list = list;
+	cursor->node = link;
+}
+
+/**
+	Puts the cursor on the back value of the list (past the front if
+	the list is empty).
+	param:	list	struct LinkedList ptr
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	list and cursor are not NULL
+	post:	cursor is on the last link
+ */
+void linkedListCursorBack(struct LinkedList* list, struct LinkedListCursor* cursor)
+{
+	assert(list != NULL && cursor != NULL);
+	struct Link* link = list->backSentinel->prev;
+	PREFETCH(link->prev);
+	cursor->list = list;
+	cursor->node = link;
+}
+
+/**
+	Returns 1 if the cursor is on a value and 0 if it is past either end.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor was set by linkedListCursorFront/Back
+	ret:	1 if on a value; otherwise, 0
+ */
+int linkedListCursorValid(struct LinkedListCursor* cursor)
+{
+	assert(cursor != NULL);
+	struct Link* link = cursor->node;
+	return link != cursor->list->frontSentinel && link != cursor->list->backSentinel;
+}
+
+/**
+	Moves the cursor to the next value and prefetches the one after it.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	post:	cursor is on the next link (past the back after the last)
+ */
+void linkedListCursorNext(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	struct Link* link = ((struct Link*)cursor->node)->next;
+	PREFETCH(link->next);
+	cursor->node = link;
+}
+
+/**
+	Moves the cursor to the previous value and prefetches the one
+	before it.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	post:	cursor is on the previous link (past the front after the first)
+ */
+void linkedListCursorPrev(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	struct Link* link = ((struct Link*)cursor->node)->prev;
+	PREFETCH(link->prev);
+	cursor->node = link;
+}
+
+/**
+	Returns the value the cursor is on.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	ret:	value of the cursor's link
+ */
+TYPE linkedListCursorGet(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	return ((struct Link*)cursor->node)->value;
+}
+
+/**
+	Removes the value the cursor is on and moves the cursor to the
+	next one. In a counted list one occurrence is removed, and the
+	cursor only moves on once the last one is gone. Other cursors on
+	the removed link become invalid.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	post:	the value is removed (call to removeOccurrence)
+ */
+void linkedListCursorErase(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	struct Link* link = cursor->node;
+	struct Link* next = link->next;
+	if (removeOccurrence(cursor->list, link)) {
+		cursor->node = next;
+	}
+}
+
+/**
+	Adds the value before the one the cursor is on, or at the back if
+	the cursor is past either end; the cursor stays where it is. In a
+	sorted list the value goes in its sorted place instead, wherever
+	the cursor is; in a counted list a value that is already there
+	only has its count bumped.
+	param:	cursor	struct LinkedListCursor ptr
+	param: 	value 	TYPE
+	pre:	cursor was set by linkedListCursorFront/Back
+	post:	value is before the cursor's link
+ */
+void linkedListCursorInsert(struct LinkedListCursor* cursor, TYPE value)
+{
+	assert(cursor != NULL);
+	struct LinkedList* list = cursor->list;
+	struct Link* link = cursor->node;
+	if (link == list->frontSentinel) {
+		link = list->backSentinel;
+	}
+	if (list->counted) {
+		addCounted(list, link, value, 1);
+	}
+	else if (list->skipHead != NULL) {
+		addSorted(list, value);
+	}
+	else {
+		addLinkBefore(list, link, value);
+	}
+}
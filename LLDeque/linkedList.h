@@ -1,6 +1,8 @@
 #ifndef LINKED_LIST_H
 #define LINKED_LIST_H
 
+#include <stdio.h>
+
 #ifndef TYPE
 #define TYPE int
 #endif
@@ -13,11 +15,48 @@
 #define EQ(A, B) ((A) == (B))
 #endif
 
+#ifndef HASH
+#define HASH(A) ((unsigned int)(A) * 2654435769u)
+#endif
+
 struct LinkedList;
 
 struct LinkedList* linkedListCreate();
+struct LinkedList* linkedListCreateHashed();
+struct LinkedList* linkedListCreateSorted();
+struct LinkedList* linkedListCreateCounted();
 void linkedListDestroy(struct LinkedList* list);
+void linkedListReserve(struct LinkedList* list, int n);
 void linkedListPrint(struct LinkedList* list);
+void linkedListSort(struct LinkedList* list);
+
+// Dump interface: writes every value from front to back through one
+// large buffer; returns 0, or -1 if a write failed. Text mode writes
+// each value with FORMAT_SPECIFIER and a newline, binary mode the raw
+// TYPE values.
+
+#define LINKED_LIST_DUMP_TEXT 0
+#define LINKED_LIST_DUMP_BINARY 1
+
+int linkedListDump(struct LinkedList* list, FILE* out, int mode);
+int linkedListDumpFd(struct LinkedList* list, int fd, int mode);
+
+// Snapshot interface (linkedListSnapshot.c): a snapshot file holds a
+// header (TYPE's name and size, value count) and the packed values.
+// A view maps one read-only; values[0] is the front value.
+
+struct LinkedListView
+{
+	const TYPE* values;
+	int size;
+	void* map;		//the whole mapped file
+	size_t bytes;	//" "
+};
+
+int linkedListSave(struct LinkedList* list, const char* path);
+struct LinkedList* linkedListLoad(const char* path);
+int linkedListViewOpen(struct LinkedListView* view, const char* path);
+void linkedListViewClose(struct LinkedListView* view);
 
 // Deque interface
 
@@ -29,10 +68,63 @@ TYPE linkedListBack(struct LinkedList* list);
 void linkedListRemoveFront(struct LinkedList* list);
 void linkedListRemoveBack(struct LinkedList* list);
 
+// Bulk interface
+
+struct LinkedList* linkedListCreateFromArray(const TYPE* values, int n);
+void linkedListAddBackN(struct LinkedList* list, const TYPE* values, int n);
+void linkedListAddFrontN(struct LinkedList* list, const TYPE* values, int n);
+int linkedListRemoveFrontN(struct LinkedList* list, TYPE* out, int n);
+int linkedListRemoveBackN(struct LinkedList* list, TYPE* out, int n);
+
 // Bag interface
 
 void linkedListAdd(struct LinkedList* list, TYPE value);
 int linkedListContains(struct LinkedList* list, TYPE value);
 void linkedListRemove(struct LinkedList* list, TYPE value);
+int linkedListCount(struct LinkedList* list, TYPE value);
+void linkedListAddMany(struct LinkedList* list, TYPE value, int n);
+
+// Range interface: values v with lo <= v < hi (by LT); O(log n + k)
+// in a list made with linkedListCreateSorted, a full scan otherwise
+
+int linkedListCountRange(struct LinkedList* list, TYPE lo, TYPE hi);
+void linkedListForEachRange(struct LinkedList* list, TYPE lo, TYPE hi,
+	void (*visit)(TYPE value, void* arg), void* arg);
+
+// Cursor interface: a cursor is on one value of a list, or past an
+// end once it moves off it. Changing the list other than through the
+// cursor invalidates it.
+
+struct LinkedListCursor
+{
+	struct LinkedList* list;
+	void* node;	//engine-specific position
+	int index;	//" "
+};
+
+void linkedListCursorFront(struct LinkedList* list, struct LinkedListCursor* cursor);
+void linkedListCursorBack(struct LinkedList* list, struct LinkedListCursor* cursor);
+int linkedListCursorValid(struct LinkedListCursor* cursor);
+void linkedListCursorNext(struct LinkedListCursor* cursor);
+void linkedListCursorPrev(struct LinkedListCursor* cursor);
+TYPE linkedListCursorGet(struct LinkedListCursor* cursor);
+void linkedListCursorErase(struct LinkedListCursor* cursor);
+void linkedListCursorInsert(struct LinkedListCursor* cursor, TYPE value);
+
+// Operation counters (only when built with -DCONTAINER_STATS)
+
+#ifdef CONTAINER_STATS
+struct LinkedListStats
+{
+	long addFront, addBack, removeFront, removeBack, front, back;
+	long add, contains, remove;
+	long nodesAllocated;	// links (chunks in the unrolled engine) handed out
+	long nodesFreed;		// " " given back
+	long bytesLive;			// bytes currently malloc'd by the list
+	long nodesTraversed;	// nodes (and towers) visited by searches and scans
+};
+
+void linkedListGetStats(struct LinkedList* list, struct LinkedListStats* stats);
+#endif
 
 #endif
\ No newline at end of file
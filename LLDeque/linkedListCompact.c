@@ -0,0 +1,931 @@
+/***********************************************************
+* Filename: linkedListCompact.c
+*
+* Overview:
+*   This program is a compact implementation of the deque and
+*	bag ADTs declared in linkedList.h. It is a drop-in
+*	replacement for linkedList.c (see makefileLLDequeBag,
+*	ENGINE=linkedListCompact) and allows for the same behavior.
+*
+*	All nodes live in one growable array and are linked with
+*	32-bit indices instead of pointers, so a node holding an int
+*	is 12 bytes instead of the 24 of a struct Link on a 64-bit
+*	build. Node 0 is the sentinel: its next is the front node and
+*	its prev the back node (0 when the list is empty), which makes
+*	the list circular and index 0 free to mean "none" anywhere
+*	else. Removed nodes are recycled through a free list chained
+*	through next. When the array is full it doubles with realloc;
+*	since no node holds an address, moving the array needs no
+*	fix-ups. linkedListSort relinks the indices, so it allocates
+*	nothing. A cursor holds a node index (0 once it is past either
+*	end), which stays valid when the array moves.
+*
+*	There is no hash index or skip list in this engine, so
+*	linkedListCreateHashed and linkedListCreateCounted return a
+*	plain list, and linkedListCount and the range queries scan
+*	every value. A list made with linkedListCreateSorted is kept
+*	in LT order by a linear insert: every add (deque, bulk, bag or
+*	cursor) walks from the front to the first value not LT the new
+*	one, and the range queries stop at the first value past hi. With
+*	-DCONTAINER_STATS the node counters count array nodes and
+*	bytesLive follows the array's capacity.
+************************************************************/
+#include "linkedList.h"
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifndef FORMAT_SPECIFIER
+#define FORMAT_SPECIFIER "%d"
+#endif
+
+#include "linkedListDump.h"
+
+// Number of nodes (sentinel included) in a new list's array.
+#ifndef COMPACT_MIN_CAPACITY
+#define COMPACT_MIN_CAPACITY 16
+#endif
+
+#ifdef CONTAINER_STATS
+#define STAT(list, field, n) ((list)->stats.field += (n))
+#else
+#define STAT(list, field, n) ((void)0)
+#endif
+
+// Hint that a node will be read soon; cursors issue it for the node
+// after the one they move to (NO_PREFETCH turns it off).
+#if defined(__GNUC__) && !defined(NO_PREFETCH)
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p) ((void)(p))
+#endif
+
+// Index-linked node; index 0 is the sentinel
+struct Node
+{
+	TYPE value;
+	uint32_t next;
+	uint32_t prev;
+};
+
+// Double linked list of nodes in one array
+struct LinkedList
+{
+	struct Node* nodes;
+	uint32_t capacity;	//nodes allocated
+	uint32_t used;		//nodes ever handed out (high-water mark)
+	uint32_t freeHead;	//first recycled node, 0 if none
+	int size;
+	int sorted;			//1 if made with linkedListCreateSorted
+#ifdef CONTAINER_STATS
+	struct LinkedListStats stats;
+#endif
+};
+
+/**
+	Resizes the node array to hold capacity nodes.
+	param: 	list 		struct LinkedList ptr
+	param: 	capacity 	uint32_t
+	pre: 	list is not NULL, capacity >= list->used
+	post: 	nodes holds the same nodes at the same indices
+ */
+static void setCapacity(struct LinkedList* list, uint32_t capacity)
+{
+	struct Node* nodes = realloc(list->nodes, (size_t)capacity * sizeof(struct Node));
+	assert(nodes != 0);
+	STAT(list, bytesLive, ((long)capacity - (long)list->capacity) * (long)sizeof(struct Node));
+	list->nodes = nodes;
+	list->capacity = capacity;
+}
+
+/**
+	Takes a node index: a recycled node if there is one, otherwise
+	the next unused node of the array (doubling it when it is full).
+	param: 	list 	struct LinkedList ptr
+	pre: 	list is not NULL
+	ret: 	node index (never 0); the node's fields are uninitialized
+ */
+static uint32_t allocNode(struct LinkedList* list)
+{
+	STAT(list, nodesAllocated, 1);
+	if (list->freeHead != 0) {
+		uint32_t i = list->freeHead;
+		list->freeHead = list->nodes[i].next;
+		return i;
+	}
+	if (list->used == list->capacity) {
+		assert(list->capacity <= UINT32_MAX / 2);
+		setCapacity(list, list->capacity * 2);
+	}
+	return list->used++;
+}
+
+/**
+	Links a new node with the given value in before node at and
+	increments the list's size.
+	param: 	list 	struct LinkedList ptr
+	param:	at 		uint32_t
+	param: 	value 	TYPE
+	pre: 	list is not NULL, at is in the list (0 = the sentinel)
+	post: 	new node w/ given value is before node at
+ */
+static void addNodeBefore(struct LinkedList* list, uint32_t at, TYPE value)
+{
+	uint32_t i = allocNode(list);
+	struct Node* nodes = list->nodes;	//after allocNode, which may move them
+	nodes[i].value = value;
+	nodes[i].next = at;
+	nodes[i].prev = nodes[at].prev;
+	nodes[nodes[at].prev].next = i;
+	nodes[at].prev = i;
+	list->size++;
+}
+
+/**
+	Unlinks node i, puts it on the free list and decrements the
+	list's size.
+	param: 	list 	struct LinkedList ptr
+	param: 	i 		uint32_t
+	pre: 	list is not NULL, i is a node in the list (not 0)
+	post: 	node i is at the head of the free list
+ */
+static void removeNode(struct LinkedList* list, uint32_t i)
+{
+	struct Node* nodes = list->nodes;
+	nodes[nodes[i].prev].next = nodes[i].next;
+	nodes[nodes[i].next].prev = nodes[i].prev;
+	nodes[i].next = list->freeHead;
+	list->freeHead = i;
+	list->size--;
+	STAT(list, nodesFreed, 1);
+}
+
+/**
+	Links a new node with the given value in before the first node
+	whose value is not LT it, so a sorted list stays in order.
+	param: 	list 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	list is not NULL and sorted
+	post: 	new node w/ given value is in its sorted place
+ */
+static void addSorted(struct LinkedList* list, TYPE value)
+{
+	struct Node* nodes = list->nodes;
+	uint32_t at = nodes[0].next;
+	while (at != 0 && LT(nodes[at].value, value)) {
+		STAT(list, nodesTraversed, 1);
+		at = nodes[at].next;
+	}
+	addNodeBefore(list, at, value);
+}
+
+/**
+	Allocates and initializes a list.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+			node array holds only the sentinel, size is 0
+	return: list
+ */
+struct LinkedList* linkedListCreate()
+{
+	struct LinkedList* list = malloc(sizeof(struct LinkedList));
+	assert(list != 0);
+#ifdef CONTAINER_STATS
+	struct LinkedListStats zero = {0};
+	list->stats = zero;
+	list->stats.bytesLive = sizeof(struct LinkedList);
+#endif
+	list->nodes = NULL;
+	list->capacity = 0;
+	setCapacity(list, COMPACT_MIN_CAPACITY);
+	list->used = 1;
+	list->freeHead = 0;
+	list->size = 0;
+	list->sorted = 0;
+	list->nodes[0].next = list->nodes[0].prev = 0;
+	return list;
+}
+
+/**
+	Same as linkedListCreate; this engine has no hash index.
+ */
+struct LinkedList* linkedListCreateHashed()
+{
+	return linkedListCreate();
+}
+
+/**
+	Allocates a list that keeps its values in LT order. This engine
+	has no skip list, so every add is a linear ordered insert.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+			list is empty and sorted
+	return: list
+ */
+struct LinkedList* linkedListCreateSorted()
+{
+	struct LinkedList* list = linkedListCreate();
+	list->sorted = 1;
+	return list;
+}
+
+/**
+	Same as linkedListCreate; duplicates are stored one per node.
+ */
+struct LinkedList* linkedListCreateCounted()
+{
+	return linkedListCreate();
+}
+
+/**
+	Frees the node array and the list itself in O(1).
+	param:	list 	struct LinkedList ptr
+	pre: 	list is not NULL
+	post: 	memory allocated to the nodes is freed
+			" " list " "
+ */
+void linkedListDestroy(struct LinkedList* list)
+{
+	assert(list != NULL);
+	free(list->nodes);
+	free(list);
+}
+
+/**
+	Makes sure the list can hold n more values without allocating.
+	Recycled nodes are not counted, so this may grow the array even
+	if the free list could hold them.
+	param:	list 	struct LinkedList ptr
+	param:	n 		int
+	pre: 	list is not NULL, n >= 0
+	post: 	at least n unused nodes are at the end of the array
+ */
+void linkedListReserve(struct LinkedList* list, int n)
+{
+	assert(list != NULL && n >= 0);
+	assert((uint64_t)list->used + (uint64_t)n <= UINT32_MAX);
+	uint32_t needed = list->used + (uint32_t)n;
+	if (needed > list->capacity) {
+		uint32_t capacity = list->capacity;
+		while (capacity < needed) {
+			capacity = capacity <= UINT32_MAX / 2 ? capacity * 2 : UINT32_MAX;
+		}
+		setCapacity(list, capacity);
+	}
+}
+
+/**
+	Adds a new node with the given value to the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not NULL
+	post: 	value is stored before the current front value; in a
+			sorted list it goes in its sorted place instead
+ */
+void linkedListAddFront(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != NULL);
+	STAT(deque, addFront, 1);
+	if (deque->sorted) {
+		addSorted(deque, value);
+		return;
+	}
+	addNodeBefore(deque, deque->nodes[0].next, value);
+}
+
+/**
+	Adds a new node with the given value to the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not NULL
+	post: 	value is stored after the current back value; in a
+			sorted list it goes in its sorted place instead
+ */
+void linkedListAddBack(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != NULL);
+	STAT(deque, addBack, 1);
+	if (deque->sorted) {
+		addSorted(deque, value);
+		return;
+	}
+	addNodeBefore(deque, 0, value);
+}
+
+/**
+	Returns the value at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not NULL
+	pre:	deque is not empty
+	post:	none
+	ret:	front value
+ */
+TYPE linkedListFront(struct LinkedList* deque)
+{
+	assert(deque != NULL && deque->size != 0);
+	STAT(deque, front, 1);
+	return deque->nodes[deque->nodes[0].next].value;
+}
+
+/**
+	Returns the value at the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not NULL
+	pre:	deque is not empty
+	post:	none
+	ret:	back value
+ */
+TYPE linkedListBack(struct LinkedList* deque)
+{
+	assert(deque != NULL && deque->size != 0);
+	STAT(deque, back, 1);
+	return deque->nodes[deque->nodes[0].prev].value;
+}
+
+/**
+	Removes the node at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not NULL
+	pre:	deque is not empty
+	post:	front node is removed and recycled (call to removeNode)
+ */
+void linkedListRemoveFront(struct LinkedList* deque)
+{
+	assert(deque != NULL && deque->size != 0);
+	STAT(deque, removeFront, 1);
+	removeNode(deque, deque->nodes[0].next);
+}
+
+/**
+	Removes the node at the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not NULL
+	pre:	deque is not empty
+	post:	back node is removed and recycled (call to removeNode)
+ */
+void linkedListRemoveBack(struct LinkedList* deque)
+{
+	assert(deque != NULL && deque->size != 0);
+	STAT(deque, removeBack, 1);
+	removeNode(deque, deque->nodes[0].prev);
+}
+
+/**
+	Allocates a list holding the given values, values[0] at the front.
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	pre: 	values is not NULL unless n is 0, n >= 0
+	post: 	memory allocated for new struct LinkedList ptr
+			list holds the n values in order
+	return: list
+ */
+struct LinkedList* linkedListCreateFromArray(const TYPE* values, int n)
+{
+	struct LinkedList* list = linkedListCreate();
+	linkedListAddBackN(list, values, n);
+	return list;
+}
+
+/**
+	Adds n values to the back of the deque, in order, so values[n - 1]
+	ends up at the back (same result as n calls to linkedListAddBack).
+	The array is grown at most once.
+	param: 	deque 	struct LinkedList ptr
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	pre:	values is not NULL unless n is 0
+	post: 	values are stored after the current back value; in a
+			sorted list each one goes in its sorted place instead
+ */
+void linkedListAddBackN(struct LinkedList* deque, const TYPE* values, int n)
+{
+	assert(deque != NULL && n >= 0);
+	assert(values != NULL || n == 0);
+	STAT(deque, addBack, n);
+	linkedListReserve(deque, n);
+	for (int i = 0; i < n; i++) {
+		if (deque->sorted)
+			addSorted(deque, values[i]);
+		else
+			addNodeBefore(deque, 0, values[i]);
+	}
+}
+
+/**
+	Adds n values to the front of the deque, one after the other, so
+	values[n - 1] ends up at the front (same result as n calls to
+	linkedListAddFront). The array is grown at most once.
+	param: 	deque 	struct LinkedList ptr
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	pre:	values is not NULL unless n is 0
+	post: 	values are stored before the current front value; in a
+			sorted list each one goes in its sorted place instead
+ */
+void linkedListAddFrontN(struct LinkedList* deque, const TYPE* values, int n)
+{
+	assert(deque != NULL && n >= 0);
+	assert(values != NULL || n == 0);
+	STAT(deque, addFront, n);
+	linkedListReserve(deque, n);
+	for (int i = 0; i < n; i++) {
+		if (deque->sorted)
+			addSorted(deque, values[i]);
+		else
+			addNodeBefore(deque, deque->nodes[0].next, values[i]);
+	}
+}
+
+/**
+	Removes up to n values from the front of the deque and copies them
+	out, front value first.
+	param: 	deque 	struct LinkedList ptr
+	param: 	out 	TYPE ptr, room for n values (or NULL to drop them)
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	post: 	the first min(n, size) nodes are recycled
+	ret: 	number of values removed
+ */
+int linkedListRemoveFrontN(struct LinkedList* deque, TYPE* out, int n)
+{
+	assert(deque != NULL && n >= 0);
+	if (n > deque->size) n = deque->size;
+	STAT(deque, removeFront, n);
+	for (int i = 0; i < n; i++) {
+		uint32_t front = deque->nodes[0].next;
+		if (out != NULL) out[i] = deque->nodes[front].value;
+		removeNode(deque, front);
+	}
+	return n;
+}
+
+/**
+	Removes up to n values from the back of the deque and copies them
+	out, back value first.
+	param: 	deque 	struct LinkedList ptr
+	param: 	out 	TYPE ptr, room for n values (or NULL to drop them)
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	post: 	the last min(n, size) nodes are recycled
+	ret: 	number of values removed
+ */
+int linkedListRemoveBackN(struct LinkedList* deque, TYPE* out, int n)
+{
+	assert(deque != NULL && n >= 0);
+	if (n > deque->size) n = deque->size;
+	STAT(deque, removeBack, n);
+	for (int i = 0; i < n; i++) {
+		uint32_t back = deque->nodes[0].prev;
+		if (out != NULL) out[i] = deque->nodes[back].value;
+		removeNode(deque, back);
+	}
+	return n;
+}
+
+/**
+	Returns 1 if the deque is empty and 0 otherwise.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not NULL
+	post:	none
+	ret:	1 if its size is 0 (empty), otherwise 0 (not empty)
+ */
+int linkedListIsEmpty(struct LinkedList* deque)
+{
+	assert(deque != NULL);
+	if(deque->size == 0) return 1; //True
+	return 0; //False
+}
+
+/**
+	Adds every value of the deque to buffer, from front to back.
+	param:	deque	struct LinkedList ptr
+	param:	buffer	struct DequeDump ptr
+	pre:	deque is not NULL, buffer was opened
+ */
+static void dumpValues(struct LinkedList* deque, struct DequeDump* buffer)
+{
+	for (uint32_t i = deque->nodes[0].next; i != 0; i = deque->nodes[i].next) {
+		dumpValue(buffer, deque->nodes[i].value);
+	}
+}
+
+/**
+	Writes the values in the deque from front to back to out.
+	param:	deque	struct LinkedList ptr
+	param:	out		FILE ptr
+	param:	mode	LINKED_LIST_DUMP_TEXT or LINKED_LIST_DUMP_BINARY
+	pre:	deque and out are not NULL
+	ret:	0 if every write succeeded; otherwise, -1
+ */
+int linkedListDump(struct LinkedList* deque, FILE* out, int mode)
+{
+	assert(deque != NULL && out != NULL);
+	struct DequeDump buffer;
+	dequeDumpOpen(&buffer, out, -1, mode);
+	dumpValues(deque, &buffer);
+	return dequeDumpClose(&buffer);
+}
+
+/**
+	Writes the values in the deque from front to back to the file
+	descriptor fd.
+	param:	deque	struct LinkedList ptr
+	param:	fd		int
+	param:	mode	LINKED_LIST_DUMP_TEXT or LINKED_LIST_DUMP_BINARY
+	pre:	deque is not NULL, fd is open for writing
+	ret:	0 if every write succeeded; otherwise, -1 (errno is set)
+ */
+int linkedListDumpFd(struct LinkedList* deque, int fd, int mode)
+{
+	assert(deque != NULL);
+	struct DequeDump buffer;
+	dequeDumpOpen(&buffer, NULL, fd, mode);
+	dumpValues(deque, &buffer);
+	return dequeDumpClose(&buffer);
+}
+
+/**
+	Prints the values in the deque from front to back, one per line.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not NULL
+	ret:	outputs to the console the values from front to back
+ */
+void linkedListPrint(struct LinkedList* deque)
+{
+	linkedListDump(deque, stdout, LINKED_LIST_DUMP_TEXT);
+}
+
+/**
+	Sorts the list by LT in O(n log n) without allocating: a stable
+	bottom-up merge sort that relinks the nodes' next indices, each
+	pass merging neighbouring sorted runs of insize nodes (ties take
+	the left run's node), then restores the prev indices. A sorted
+	list is already in order.
+	param: 	list 	struct LinkedList ptr
+	pre: 	list is not NULL
+	post: 	nodes are in LT order from front to back; equal values
+			keep their relative order
+ */
+void linkedListSort(struct LinkedList* list)
+{
+	assert(list != NULL);
+	if (list->size < 2 || list->sorted) return;
+	struct Node* nodes = list->nodes;
+	//The back node's next is 0, which ends the chain.
+	uint32_t head = nodes[0].next;
+	for (int insize = 1; ; insize *= 2) {
+		uint32_t p = head;
+		uint32_t tail = 0;
+		int merges = 0;
+		while (p != 0) {
+			uint32_t q = p;
+			int psize = 0;
+			merges++;
+			while (psize < insize && q != 0) {
+				psize++;
+				q = nodes[q].next;
+			}
+			int qsize = insize;
+			while (psize > 0 || (qsize > 0 && q != 0)) {
+				uint32_t e;
+				if (psize == 0 || (qsize > 0 && q != 0 && LT(nodes[q].value, nodes[p].value))) {
+					e = q;
+					q = nodes[q].next;
+					qsize--;
+				}
+				else {
+					e = p;
+					p = nodes[p].next;
+					psize--;
+				}
+				STAT(list, nodesTraversed, 1);
+				nodes[tail].next = e;	//tail 0 is the sentinel, so this sets head too
+				tail = e;
+			}
+			p = q;
+		}
+		nodes[tail].next = 0;
+		head = nodes[0].next;
+		if (merges <= 1) break;
+	}
+	//Restore the prev indices.
+	uint32_t prev = 0;
+	for (uint32_t i = head; i != 0; i = nodes[i].next) {
+		nodes[i].prev = prev;
+		prev = i;
+	}
+	nodes[0].prev = prev;
+}
+
+#ifdef CONTAINER_STATS
+/**
+	Copies the list's operation counters into stats.
+	param:	list	struct LinkedList ptr
+	param:	stats	struct LinkedListStats ptr
+	pre:	list and stats are not NULL
+	post:	stats holds the counts since the list was created
+ */
+void linkedListGetStats(struct LinkedList* list, struct LinkedListStats* stats)
+{
+	assert(list != NULL && stats != NULL);
+	*stats = list->stats;
+}
+#endif
+
+////////////////BAG/////////////////BAG///////////BAG////////////////
+/**
+	Adds the given value to the bag (at the front, like linkedList.c,
+	or in its sorted place in a sorted list).
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not NULL
+	post: 	value is in the bag
+ */
+void linkedListAdd(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != NULL);
+	STAT(bag, add, 1);
+	if (bag->sorted) {
+		addSorted(bag, value);
+		return;
+	}
+	addNodeBefore(bag, bag->nodes[0].next, value);
+}
+
+/**
+	Returns the index of the first node with the given value, or 0.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not NULL
+	ret:	node index or 0 if no node has the value
+ */
+static uint32_t findNode(struct LinkedList* bag, TYPE value)
+{
+	struct Node* nodes = bag->nodes;
+	for (uint32_t i = nodes[0].next; i != 0; i = nodes[i].next) {
+		STAT(bag, nodesTraversed, 1);
+		if (EQ(nodes[i].value, value)) return i;
+	}
+	return 0;
+}
+
+/**
+	Returns 1 if the value is in the bag and 0 otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not NULL
+	post:	none
+	ret:	1 if value found; otherwise, 0
+ */
+int linkedListContains(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != NULL);
+	STAT(bag, contains, 1);
+	return findNode(bag, value) != 0;
+}
+
+/**
+	Removes the first occurrence of the given value.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not NULL
+	pre:	bag is not empty
+	post:	if value found, its first node is removed (call to removeNode)
+ */
+void linkedListRemove(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != NULL);
+	assert(!linkedListIsEmpty(bag));
+	STAT(bag, remove, 1);
+	uint32_t i = findNode(bag, value);
+	if (i != 0) {
+		removeNode(bag, i);
+	}
+}
+
+/**
+	Returns the number of times the value is in the bag, scanning
+	every value.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not NULL
+	post:	none
+	ret:	occurrences of value
+ */
+int linkedListCount(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != NULL);
+	STAT(bag, contains, 1);
+	int count = 0;
+	struct Node* nodes = bag->nodes;
+	for (uint32_t i = nodes[0].next; i != 0; i = nodes[i].next) {
+		STAT(bag, nodesTraversed, 1);
+		if (EQ(nodes[i].value, value)) count++;
+	}
+	return count;
+}
+
+/**
+	Adds n occurrences of the value to the front of the bag (same
+	result as n calls to linkedListAdd).
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	param: 	n 		int
+	pre: 	bag is not NULL, n >= 0
+	post: 	value is in the bag n more times
+ */
+void linkedListAddMany(struct LinkedList* bag, TYPE value, int n)
+{
+	assert(bag != NULL && n >= 0);
+	STAT(bag, add, n);
+	linkedListReserve(bag, n);
+	for (int i = 0; i < n; i++) {
+		if (bag->sorted)
+			addSorted(bag, value);
+		else
+			addNodeBefore(bag, bag->nodes[0].next, value);
+	}
+}
+
+/**
+	Returns the number of values v in the bag with lo <= v < hi
+	(by LT), scanning every value (up to the first one past hi in a
+	sorted list).
+	param:	bag		struct LinkedList ptr
+	param: 	lo 		TYPE
+	param: 	hi 		TYPE
+	pre: 	bag is not NULL
+	post:	none
+	ret:	number of values in [lo, hi)
+ */
+int linkedListCountRange(struct LinkedList* bag, TYPE lo, TYPE hi)
+{
+	assert(bag != NULL);
+	int count = 0;
+	struct Node* nodes = bag->nodes;
+	for (uint32_t i = nodes[0].next; i != 0; i = nodes[i].next) {
+		STAT(bag, nodesTraversed, 1);
+		if (!LT(nodes[i].value, hi)) {
+			if (bag->sorted) break;
+			continue;
+		}
+		if (!LT(nodes[i].value, lo)) count++;
+	}
+	return count;
+}
+
+/**
+	Calls visit(v, arg) for every value v in the bag with lo <= v < hi
+	(by LT), front to back, scanning every value (up to the first
+	one past hi in a sorted list).
+	param:	bag		struct LinkedList ptr
+	param: 	lo 		TYPE
+	param: 	hi 		TYPE
+	param: 	visit 	function called with each value and arg
+	param: 	arg 	void ptr passed through to visit
+	pre: 	bag and visit are not NULL
+	pre:	visit does not change the bag
+ */
+void linkedListForEachRange(struct LinkedList* bag, TYPE lo, TYPE hi,
+	void (*visit)(TYPE value, void* arg), void* arg)
+{
+	assert(bag != NULL && visit != NULL);
+	struct Node* nodes = bag->nodes;
+	for (uint32_t i = nodes[0].next; i != 0; i = nodes[i].next) {
+		STAT(bag, nodesTraversed, 1);
+		if (!LT(nodes[i].value, hi)) {
+			if (bag->sorted) break;
+			continue;
+		}
+		if (!LT(nodes[i].value, lo)) visit(nodes[i].value, arg);
+	}
+}
+
+////////////////CURSOR//////////////CURSOR////////CURSOR/////////////
+/**
+	Puts the cursor on the front value of the list (past the back if
+	the list is empty).
+	param:	list	struct LinkedList ptr
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	list and cursor are not NULL
+	post:	cursor index is the first node
+ */
+void linkedListCursorFront(struct LinkedList* list, struct LinkedListCursor* cursor)
+{
+	assert(list != NULL && cursor != NULL);
+	uint32_t i = list->nodes[0].next;
+	PREFETCH(&list->nodes[list->nodes[i].next]);
+	cursor->list = list;
+	cursor->node = NULL;
+	cursor->index = (int)i;
+}
+
+/**
+	Puts the cursor on the back value of the list (past the front if
+	the list is empty).
+	param:	list	struct LinkedList ptr
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	list and cursor are not NULL
+	post:	cursor index is the last node
+ */
+void linkedListCursorBack(struct LinkedList* list, struct LinkedListCursor* cursor)
+{
+	assert(list != NULL && cursor != NULL);
+	uint32_t i = list->nodes[0].prev;
+	PREFETCH(&list->nodes[list->nodes[i].prev]);
+	cursor->list = list;
+	cursor->node = NULL;
+	cursor->index = (int)i;
+}
+
+/**
+	Returns 1 if the cursor is on a value and 0 if it is past either end.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor was set by linkedListCursorFront/Back
+	ret:	1 if on a value; otherwise, 0
+ */
+int linkedListCursorValid(struct LinkedListCursor* cursor)
+{
+	assert(cursor != NULL);
+	return cursor->index != 0;
+}
+
+/**
+	Moves the cursor to the next value and prefetches the one after it.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	post:	cursor is on the next node (past the back after the last)
+ */
+void linkedListCursorNext(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	struct Node* nodes = cursor->list->nodes;
+	uint32_t i = nodes[(uint32_t)cursor->index].next;
+	PREFETCH(&nodes[nodes[i].next]);
+	cursor->index = (int)i;
+}
+
+/**
+	Moves the cursor to the previous value and prefetches the one
+	before it.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	post:	cursor is on the previous node (past the front after the first)
+ */
+void linkedListCursorPrev(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	struct Node* nodes = cursor->list->nodes;
+	uint32_t i = nodes[(uint32_t)cursor->index].prev;
+	PREFETCH(&nodes[nodes[i].prev]);
+	cursor->index = (int)i;
+}
+
+/**
+	Returns the value the cursor is on.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	ret:	value of the cursor's node
+ */
+TYPE linkedListCursorGet(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	return cursor->list->nodes[(uint32_t)cursor->index].value;
+}
+
+/**
+	Removes the value the cursor is on and moves the cursor to the
+	next one. Other cursors on the removed node become invalid.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	post:	the node is recycled (call to removeNode)
+ */
+void linkedListCursorErase(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	uint32_t i = (uint32_t)cursor->index;
+	uint32_t next = cursor->list->nodes[i].next;
+	removeNode(cursor->list, i);
+	cursor->index = (int)next;
+}
+
+/**
+	Adds the value before the one the cursor is on, or at the back if
+	the cursor is past either end; the cursor stays where it is.
+	param:	cursor	struct LinkedListCursor ptr
+	param: 	value 	TYPE
+	pre:	cursor was set by linkedListCursorFront/Back
+	post:	value is before the cursor's node; in a sorted list it
+			goes in its sorted place instead
+ */
+void linkedListCursorInsert(struct LinkedListCursor* cursor, TYPE value)
+{
+	assert(cursor != NULL);
+	if (cursor->list->sorted)
+		addSorted(cursor->list, value);
+	else
+		addNodeBefore(cursor->list, (uint32_t)cursor->index, value);
+}
@@ -0,0 +1,44 @@
+/***********************************************************
+* Filename: linkedListDump.h
+*
+* Overview:
+*   Value writer the linkedList engines share for
+*	linkedListDump, linkedListDumpFd and linkedListPrint. The
+*	buffering (struct DequeDump, dequeDumpOpen/dequeDumpClose) is
+*	the one in dequeTemplate.h, which the circularList engines use
+*	too; this header adds dumpValue for this build's TYPE.
+*
+*	Text mode writes each value with FORMAT_SPECIFIER and a
+*	newline. The default "%d" is formatted by hand; any other
+*	FORMAT_SPECIFIER goes through snprintf. Binary mode copies
+*	the raw TYPE values, in host byte order.
+*
+*	Every function is static, so each engine gets its own copy.
+*	Include it after FORMAT_SPECIFIER is defined.
+************************************************************/
+#ifndef LINKED_LIST_DUMP_H
+#define LINKED_LIST_DUMP_H
+
+#include <stdio.h>
+#include <string.h>
+#include "../CLDeque/dequeTemplate.h"
+
+/**
+	Formats value as text with FORMAT_SPECIFIER, the way snprintf
+	does.
+	param: 	out 	char ptr
+	param: 	room 	int, at least 20
+	param: 	value 	TYPE
+	ret: 	number of characters value needs
+ */
+static inline int formatValue(char* out, int room, TYPE value)
+{
+	if (strcmp(FORMAT_SPECIFIER, "%d") == 0) {
+		return dequeFormatDecimal(out, (long long)value);
+	}
+	return snprintf(out, room, FORMAT_SPECIFIER, value);
+}
+
+DEQUE_DEFINE_DUMP_VALUE(dumpValue, TYPE, formatValue)
+
+#endif
@@ -0,0 +1,214 @@
+/***********************************************************
+* Filename: linkedListIntrusive.c
+*
+* Overview:
+*   This program is an intrusive version of the linked list
+*	deque in linkedList.c. Instead of copying a TYPE value into
+*	a link it allocates, the list links together IntrusiveLink
+*	headers that the caller embeds in its own objects:
+*
+*		struct Record { int id; struct IntrusiveLink link; };
+*		intrusiveLinkedListAddBack(list, &record->link);
+*		...
+*		struct Record* r = CONTAINER_OF(
+*			intrusiveLinkedListFront(list), struct Record, link);
+*
+*	so adding and removing never allocate, and a link can be
+*	unlinked from the middle in O(1) (intrusiveLinkedListRemove).
+*	The list only owns its head: destroying it does not touch
+*	the objects, and the caller keeps each object alive while
+*	its link is in a list.
+*
+*	Like linkedList.c it uses a front and a back sentinel; here
+*	they are members of the list itself, so the list is a single
+*	allocation.
+*
+* Usage:
+* 	gcc -g -Wall -std=c99 -c linkedListIntrusive.c
+************************************************************/
+#include "linkedListIntrusive.h"
+#include <assert.h>
+#include <stdlib.h>
+
+// Double linked list of caller-owned links with front and back sentinels
+struct IntrusiveLinkedList
+{
+	struct IntrusiveLink frontSentinel;
+	struct IntrusiveLink backSentinel;
+	int size;
+};
+
+/**
+	Links the given link in between prev and next.
+	param: 	list 	struct IntrusiveLinkedList ptr
+	param: 	link 	struct IntrusiveLink ptr
+	param: 	prev 	struct IntrusiveLink ptr
+	param: 	next 	struct IntrusiveLink ptr
+	pre: 	prev->next is next, link is not in a list
+	post: 	link is between prev and next, size is incremented by 1
+ */
+static void linkBetween(struct IntrusiveLinkedList* list, struct IntrusiveLink* link,
+	struct IntrusiveLink* prev, struct IntrusiveLink* next)
+{
+	link->prev = prev;
+	link->next = next;
+	prev->next = link;
+	next->prev = link;
+	list->size++;
+}
+
+/**
+	Allocates and initializes an empty list.
+	pre: 	none
+	post: 	memory allocated for new struct IntrusiveLinkedList ptr
+			front sentinel next points to back, back prev to front
+	return: list
+ */
+struct IntrusiveLinkedList* intrusiveLinkedListCreate()
+{
+	struct IntrusiveLinkedList* list = malloc(sizeof(struct IntrusiveLinkedList));
+	assert(list != 0);
+	list->frontSentinel.prev = NULL;
+	list->frontSentinel.next = &list->backSentinel;
+	list->backSentinel.prev = &list->frontSentinel;
+	list->backSentinel.next = NULL;
+	list->size = 0;
+	return list;
+}
+
+/**
+	Frees the list. The objects whose links are still in it are not
+	touched; it is up to the caller to free them.
+	param:	list 	struct IntrusiveLinkedList ptr
+	pre: 	list is not NULL
+	post: 	memory allocated to the list is freed
+ */
+void intrusiveLinkedListDestroy(struct IntrusiveLinkedList* list)
+{
+	assert(list != NULL);
+	free(list);
+}
+
+/**
+	Returns the number of links in the list.
+	param:	list 	struct IntrusiveLinkedList ptr
+	pre: 	list is not NULL
+	ret: 	size
+ */
+int intrusiveLinkedListSize(struct IntrusiveLinkedList* list)
+{
+	assert(list != NULL);
+	return list->size;
+}
+
+/**
+	Returns 1 if the list is empty and 0 otherwise.
+	param:	list 	struct IntrusiveLinkedList ptr
+	pre: 	list is not NULL
+	ret: 	1 if its size is 0 (empty), otherwise 0 (not empty)
+ */
+int intrusiveLinkedListIsEmpty(struct IntrusiveLinkedList* list)
+{
+	assert(list != NULL);
+	return list->size == 0;
+}
+
+/**
+	Adds the given link to the front of the list.
+	param: 	list 	struct IntrusiveLinkedList ptr
+	param: 	link 	struct IntrusiveLink ptr
+	pre: 	list and link are not NULL, link is not in a list
+	post: 	link is the first link
+ */
+void intrusiveLinkedListAddFront(struct IntrusiveLinkedList* list, struct IntrusiveLink* link)
+{
+	assert(list != NULL && link != NULL);
+	linkBetween(list, link, &list->frontSentinel, list->frontSentinel.next);
+}
+
+/**
+	Adds the given link to the back of the list.
+	param: 	list 	struct IntrusiveLinkedList ptr
+	param: 	link 	struct IntrusiveLink ptr
+	pre: 	list and link are not NULL, link is not in a list
+	post: 	link is the last link
+ */
+void intrusiveLinkedListAddBack(struct IntrusiveLinkedList* list, struct IntrusiveLink* link)
+{
+	assert(list != NULL && link != NULL);
+	linkBetween(list, link, list->backSentinel.prev, &list->backSentinel);
+}
+
+/**
+	Returns the first link of the list.
+	param: 	list 	struct IntrusiveLinkedList ptr
+	pre:	list is not NULL
+	pre:	list is not empty
+	ret:	first link (use CONTAINER_OF to get its object)
+ */
+struct IntrusiveLink* intrusiveLinkedListFront(struct IntrusiveLinkedList* list)
+{
+	assert(list != NULL && list->size != 0);
+	return list->frontSentinel.next;
+}
+
+/**
+	Returns the last link of the list.
+	param: 	list 	struct IntrusiveLinkedList ptr
+	pre:	list is not NULL
+	pre:	list is not empty
+	ret:	last link (use CONTAINER_OF to get its object)
+ */
+struct IntrusiveLink* intrusiveLinkedListBack(struct IntrusiveLinkedList* list)
+{
+	assert(list != NULL && list->size != 0);
+	return list->backSentinel.prev;
+}
+
+/**
+	Unlinks the given link from the list in O(1).
+	param: 	list 	struct IntrusiveLinkedList ptr
+	param: 	link 	struct IntrusiveLink ptr
+	pre: 	list and link are not NULL, link is in list
+	post: 	link is no longer in the list; its next and prev are NULL
+			list size is decremented by 1
+ */
+void intrusiveLinkedListRemove(struct IntrusiveLinkedList* list, struct IntrusiveLink* link)
+{
+	assert(list != NULL && link != NULL && list->size != 0);
+	assert(link != &list->frontSentinel && link != &list->backSentinel);
+	link->prev->next = link->next;
+	link->next->prev = link->prev;
+	link->next = link->prev = NULL;
+	list->size--;
+}
+
+/**
+	Unlinks the first link of the list and returns it.
+	param: 	list 	struct IntrusiveLinkedList ptr
+	pre:	list is not NULL
+	pre:	list is not empty
+	post:	first link is removed (call to intrusiveLinkedListRemove)
+	ret:	removed link
+ */
+struct IntrusiveLink* intrusiveLinkedListRemoveFront(struct IntrusiveLinkedList* list)
+{
+	struct IntrusiveLink* link = intrusiveLinkedListFront(list);
+	intrusiveLinkedListRemove(list, link);
+	return link;
+}
+
+/**
+	Unlinks the last link of the list and returns it.
+	param: 	list 	struct IntrusiveLinkedList ptr
+	pre:	list is not NULL
+	pre:	list is not empty
+	post:	last link is removed (call to intrusiveLinkedListRemove)
+	ret:	removed link
+ */
+struct IntrusiveLink* intrusiveLinkedListRemoveBack(struct IntrusiveLinkedList* list)
+{
+	struct IntrusiveLink* link = intrusiveLinkedListBack(list);
+	intrusiveLinkedListRemove(list, link);
+	return link;
+}
@@ -0,0 +1,37 @@
+#ifndef LINKED_LIST_INTRUSIVE_H
+#define LINKED_LIST_INTRUSIVE_H
+
+#include <stddef.h>
+
+// Returns the object of the given type whose member is at ptr.
+#ifndef CONTAINER_OF
+#define CONTAINER_OF(ptr, type, member) \
+	((type*)((char*)(ptr) - offsetof(type, member)))
+#endif
+
+// Link header embedded in the caller's objects; an object can be in
+// one list per IntrusiveLink member.
+struct IntrusiveLink
+{
+	struct IntrusiveLink* next;
+	struct IntrusiveLink* prev;
+};
+
+struct IntrusiveLinkedList;
+
+struct IntrusiveLinkedList* intrusiveLinkedListCreate();
+void intrusiveLinkedListDestroy(struct IntrusiveLinkedList* list);
+int intrusiveLinkedListSize(struct IntrusiveLinkedList* list);
+
+// Deque interface; no call allocates or frees a link
+
+int intrusiveLinkedListIsEmpty(struct IntrusiveLinkedList* list);
+void intrusiveLinkedListAddFront(struct IntrusiveLinkedList* list, struct IntrusiveLink* link);
+void intrusiveLinkedListAddBack(struct IntrusiveLinkedList* list, struct IntrusiveLink* link);
+struct IntrusiveLink* intrusiveLinkedListFront(struct IntrusiveLinkedList* list);
+struct IntrusiveLink* intrusiveLinkedListBack(struct IntrusiveLinkedList* list);
+struct IntrusiveLink* intrusiveLinkedListRemoveFront(struct IntrusiveLinkedList* list);
+struct IntrusiveLink* intrusiveLinkedListRemoveBack(struct IntrusiveLinkedList* list);
+void intrusiveLinkedListRemove(struct IntrusiveLinkedList* list, struct IntrusiveLink* link);
+
+#endif
@@ -0,0 +1,66 @@
+/***********************************************************
+* Filename: linkedListIntrusiveMain.c
+*
+* Overview:
+*   Tests the intrusive linked list deque (linkedListIntrusive.c)
+*	with records that embed their own link.
+*
+* Usage:
+* 	1) make -f makefileLLDequeBag intrusive
+*	2) ./intrusive
+************************************************************/
+#include "linkedListIntrusive.h"
+#include <stdio.h>
+
+struct Record {
+	int id;
+	struct IntrusiveLink link;
+};
+
+void assertTrue(int pred, char* msg)
+{
+	printf("%s: ", msg);
+	if(pred)
+		printf("\tPASSED\n");
+	else
+		printf("\tFAILED\n");
+}
+
+int idOf(struct IntrusiveLink* link)
+{
+	return CONTAINER_OF(link, struct Record, link)->id;
+}
+
+int main()
+{
+	struct Record records[6];
+	for (int i = 0; i < 6; i++) {
+		records[i].id = i + 1;
+	}
+	struct IntrusiveLinkedList* list = intrusiveLinkedListCreate();
+	assertTrue(intrusiveLinkedListIsEmpty(list), "new list is empty");
+	intrusiveLinkedListAddFront(list, &records[0].link);
+	intrusiveLinkedListAddBack(list, &records[1].link);
+	intrusiveLinkedListAddBack(list, &records[2].link);
+	intrusiveLinkedListAddFront(list, &records[3].link);
+	intrusiveLinkedListAddFront(list, &records[4].link);
+	intrusiveLinkedListAddBack(list, &records[5].link);
+	//List is now 5 4 1 2 3 6.
+	assertTrue(intrusiveLinkedListSize(list) == 6, "size == 6");
+	assertTrue(idOf(intrusiveLinkedListFront(list)) == 5, "front id == 5");
+	assertTrue(idOf(intrusiveLinkedListBack(list)) == 6, "back id == 6");
+	assertTrue(idOf(intrusiveLinkedListRemoveFront(list)) == 5, "remove front id == 5");
+	assertTrue(idOf(intrusiveLinkedListRemoveBack(list)) == 6, "remove back id == 6");
+	intrusiveLinkedListRemove(list, &records[0].link);
+	assertTrue(records[0].link.next == NULL, "removed link is detached");
+	//List is now 4 2 3.
+	int ok = 1;
+	int expected[] = {4, 2, 3};
+	for (int i = 0; i < 3; i++) {
+		ok = ok && idOf(intrusiveLinkedListRemoveFront(list)) == expected[i];
+	}
+	assertTrue(ok, "remaining ids are 4 2 3");
+	assertTrue(intrusiveLinkedListIsEmpty(list), "list is empty");
+	intrusiveLinkedListDestroy(list);
+	return 0;
+}
@@ -1,31 +1,235 @@
+/***********************************************************
+* Filename: linkedListMain.c
+*
+* Overview:
+*   Tests the deque and bag interfaces of the engine the makefile
+*	builds, then each list mode against known values: the hash index
+*	(contains and remove), counted links (counts and removing
+*	duplicates), bulk create and drain, cursors (walking both ways,
+*	erase and insert) and text and binary dumps. make check runs it,
+*	and the sorted test, for every engine.
+*
+* Usage:
+* 	1) make -f makefileLLDequeBag prog [ENGINE=...]
+*	2) ./prog
+************************************************************/
+#define _POSIX_C_SOURCE 200809L
 #include "linkedList.h"
 #include <stdio.h>
+#include <string.h>
+
+#define BULK_VALUES 1000
+#define HASHED_VALUES 200
+#define HASHED_DISTINCT 50
+
+void assertTrue(int pred, char* msg)
+{
+	printf("%s: ", msg);
+	if(pred)
+		printf("\tPASSED\n");
+	else
+		printf("\tFAILED\n");
+}
+
+// Returns 1 if a cursor walk from the front sees exactly the n
+// values, in order.
+int holds(struct LinkedList* list, const TYPE* values, int n)
+{
+	struct LinkedListCursor cursor;
+	int seen = 0;
+	for (linkedListCursorFront(list, &cursor); linkedListCursorValid(&cursor);
+		linkedListCursorNext(&cursor)) {
+		if (seen == n || !EQ(linkedListCursorGet(&cursor), values[seen])) return 0;
+		seen++;
+	}
+	return seen == n;
+}
+
+// Returns 1 if the file holds exactly the given bytes.
+int fileHolds(FILE* file, const void* bytes, size_t n)
+{
+	char read[256];
+	rewind(file);
+	return n <= sizeof(read) && fread(read, 1, sizeof(read), file) == n
+		&& memcmp(read, bytes, n) == 0;
+}
 
 int main(){
-	struct LinkedList* l = linkedListCreate(); 
+	/* DEQUE */
+	struct LinkedList* l = linkedListCreate();
 	linkedListAddFront(l, (TYPE)1);
 	linkedListAddBack(l, (TYPE)2);
 	linkedListAddBack(l, (TYPE)3);
 	linkedListAddFront(l, (TYPE)4);
 	linkedListAddFront(l, (TYPE)5);
 	linkedListAddBack(l, (TYPE)6);
-	linkedListPrint(l);
-	printf("%i\n", linkedListFront(l));
-	printf("%i\n", linkedListBack(l));
+	TYPE added[] = {5, 4, 1, 2, 3, 6};
+	assertTrue(holds(l, added, 6), "deque adds: 5 4 1 2 3 6");
+	assertTrue(linkedListFront(l) == 5 && linkedListBack(l) == 6, "front == 5, back == 6");
 	linkedListRemoveFront(l);
 	linkedListRemoveBack(l);
-	linkedListPrint(l);
-        linkedListDestroy(l);
-/* BAG */
-	
-      struct LinkedList* k = linkedListCreate(); 
-       linkedListAdd (k, (TYPE)10);
-       linkedListAdd (k, (TYPE)11);
-        linkedListAdd (k, (TYPE)13);
-       linkedListAdd(k, (TYPE)14);
-       linkedListRemove(k, (TYPE)11);
-        linkedListPrint(k);
-        linkedListDestroy(k);
+	TYPE removed[] = {4, 1, 2, 3};
+	assertTrue(holds(l, removed, 4), "remove front and back: 4 1 2 3");
+	linkedListSort(l);
+	TYPE sorted[] = {1, 2, 3, 4};
+	assertTrue(holds(l, sorted, 4), "sort: 1 2 3 4");
+	linkedListDestroy(l);
+
+	/* BAG */
+	struct LinkedList* k = linkedListCreate();
+	linkedListAdd(k, (TYPE)10);
+	linkedListAdd(k, (TYPE)11);
+	linkedListAdd(k, (TYPE)13);
+	linkedListAdd(k, (TYPE)14);
+	linkedListRemove(k, (TYPE)11);
+	assertTrue(!linkedListContains(k, (TYPE)11) && linkedListContains(k, (TYPE)13),
+		"bag remove: 11 gone, 13 kept");
+	assertTrue(linkedListCount(k, (TYPE)10) == 1 && linkedListCount(k, (TYPE)12) == 0,
+		"bag count: 10 once, 12 never");
+	linkedListDestroy(k);
+
+	/* HASHED */
+	struct LinkedList* h = linkedListCreateHashed();
+	for (int i = 0; i < HASHED_VALUES; i++) {
+		if (i % 3 == 0) linkedListAddFront(h, (TYPE)(i % HASHED_DISTINCT));
+		else if (i % 3 == 1) linkedListAddBack(h, (TYPE)(i % HASHED_DISTINCT));
+		else linkedListAdd(h, (TYPE)(i % HASHED_DISTINCT));
+	}
+	int found = 1;
+	for (int i = 0; i < HASHED_DISTINCT; i++) {
+		found = found && linkedListContains(h, (TYPE)i);
+	}
+	assertTrue(found && !linkedListContains(h, (TYPE)HASHED_DISTINCT)
+		&& !linkedListContains(h, (TYPE)-1), "hashed contains every value added, and no other");
+	assertTrue(linkedListCount(h, (TYPE)7) == HASHED_VALUES / HASHED_DISTINCT,
+		"hashed count of 7 == 4");
+	linkedListRemove(h, (TYPE)7);
+	linkedListRemove(h, (TYPE)7);
+	assertTrue(linkedListCount(h, (TYPE)7) == 2 && linkedListContains(h, (TYPE)7),
+		"hashed remove takes one occurrence at a time");
+	linkedListRemove(h, (TYPE)7);
+	linkedListRemove(h, (TYPE)7);
+	linkedListRemove(h, (TYPE)7);
+	assertTrue(!linkedListContains(h, (TYPE)7) && linkedListContains(h, (TYPE)8),
+		"hashed remove of the last 7 leaves 8");
+	linkedListRemoveFrontN(h, NULL, HASHED_VALUES / 2);
+	linkedListRemoveBackN(h, NULL, HASHED_VALUES);
+	assertTrue(linkedListIsEmpty(h) && !linkedListContains(h, (TYPE)8),
+		"hashed drain leaves nothing to find");
+	linkedListAddBack(h, (TYPE)8);
+	assertTrue(linkedListContains(h, (TYPE)8), "hashed contains after a drain");
+	linkedListDestroy(h);
+
+	/* COUNTED */
+	struct LinkedList* c = linkedListCreateCounted();
+	linkedListAddMany(c, (TYPE)5, 3);
+	linkedListAdd(c, (TYPE)5);
+	linkedListAdd(c, (TYPE)6);
+	linkedListAddFront(c, (TYPE)5);
+	linkedListAddBack(c, (TYPE)7);
+	assertTrue(linkedListCount(c, (TYPE)5) == 5 && linkedListCount(c, (TYPE)6) == 1
+		&& linkedListCount(c, (TYPE)8) == 0, "counted: 5 five times, 6 once, 8 never");
+	linkedListRemove(c, (TYPE)5);
+	linkedListRemove(c, (TYPE)5);
+	assertTrue(linkedListCount(c, (TYPE)5) == 3, "counted remove takes one duplicate at a time");
+	linkedListRemove(c, (TYPE)6);
+	linkedListRemove(c, (TYPE)6);
+	assertTrue(linkedListCount(c, (TYPE)6) == 0 && !linkedListContains(c, (TYPE)6),
+		"counted remove of the last 6, then of a missing 6");
+	TYPE drained[8];
+	int n = linkedListRemoveFrontN(c, drained, 8);
+	int fives = 0, sevens = 0;
+	for (int i = 0; i < n; i++) {
+		fives += drained[i] == 5;
+		sevens += drained[i] == 7;
+	}
+	assertTrue(n == 4 && fives == 3 && sevens == 1 && linkedListIsEmpty(c),
+		"counted drain returns every occurrence");
+	linkedListDestroy(c);
+
+	/* BULK */
+	TYPE values[BULK_VALUES];
+	for (int i = 0; i < BULK_VALUES; i++) {
+		values[i] = (TYPE)i;
+	}
+	struct LinkedList* b = linkedListCreateFromArray(values, BULK_VALUES);
+	assertTrue(holds(b, values, BULK_VALUES), "create from array keeps the order");
+	TYPE front[] = {-3, -2, -1};
+	TYPE back[] = {1000, 1001};
+	linkedListAddFrontN(b, front, 3);
+	linkedListAddBackN(b, back, 2);
+	assertTrue(linkedListFront(b) == -1 && linkedListBack(b) == 1001,
+		"add front N puts the last value first, add back N the last value last");
+	TYPE out[BULK_VALUES + 5];
+	n = linkedListRemoveFrontN(b, out, 4);
+	assertTrue(n == 4 && out[0] == -1 && out[1] == -2 && out[2] == -3 && out[3] == 0,
+		"remove front N: -1 -2 -3 0");
+	n = linkedListRemoveBackN(b, out, 3);
+	assertTrue(n == 3 && out[0] == 1001 && out[1] == 1000 && out[2] == 999,
+		"remove back N: 1001 1000 999");
+	n = linkedListRemoveFrontN(b, out, BULK_VALUES + 5);
+	int inOrder = n == BULK_VALUES - 2;
+	for (int i = 0; inOrder && i < n; i++) {
+		inOrder = out[i] == i + 1;
+	}
+	assertTrue(inOrder && linkedListIsEmpty(b), "drain returns 1 to 998, in order");
+	assertTrue(linkedListRemoveBackN(b, out, 1) == 0, "remove back N of an empty list");
+	linkedListDestroy(b);
+
+	/* CURSORS */
+	struct LinkedList* r = linkedListCreateFromArray(values, BULK_VALUES);
+	struct LinkedListCursor cursor;
+	linkedListCursorFront(r, &cursor);
+	while (linkedListCursorValid(&cursor)) {
+		linkedListCursorNext(&cursor);
+		if (linkedListCursorValid(&cursor)) linkedListCursorErase(&cursor);
+	}
+	int evens = 1;
+	int seen = 0;
+	for (linkedListCursorBack(r, &cursor); linkedListCursorValid(&cursor);
+		linkedListCursorPrev(&cursor)) {
+		evens = evens && linkedListCursorGet(&cursor) == BULK_VALUES - 2 - 2 * seen;
+		seen++;
+	}
+	assertTrue(evens && seen == BULK_VALUES / 2, "erasing every other value leaves the evens");
+	linkedListCursorFront(r, &cursor);
+	linkedListCursorNext(&cursor);
+	linkedListCursorInsert(&cursor, (TYPE)-1);
+	assertTrue(linkedListCursorGet(&cursor) == 2, "insert leaves the cursor on its value");
+	linkedListCursorPrev(&cursor);
+	assertTrue(linkedListCursorGet(&cursor) == -1, "insert goes before the cursor");
+	linkedListCursorPrev(&cursor);
+	linkedListCursorPrev(&cursor);
+	assertTrue(!linkedListCursorValid(&cursor), "prev from the front leaves the list");
+	linkedListCursorInsert(&cursor, (TYPE)-2);
+	assertTrue(linkedListBack(r) == -2, "insert past an end adds at the back");
+	linkedListCursorBack(r, &cursor);
+	linkedListCursorErase(&cursor);
+	assertTrue(!linkedListCursorValid(&cursor) && linkedListBack(r) == BULK_VALUES - 2,
+		"erasing the back value leaves the cursor past the end");
+	linkedListDestroy(r);
+
+	/* DUMPS */
+	TYPE dumped[] = {-12, 0, 7, 100000};
+	struct LinkedList* d = linkedListCreateFromArray(dumped, 4);
+	FILE* file = tmpfile();
+	assertTrue(file != NULL && linkedListDump(d, file, LINKED_LIST_DUMP_TEXT) == 0
+		&& fileHolds(file, "-12\n0\n7\n100000\n", 15), "text dump");
+	fclose(file);
+	file = tmpfile();
+	assertTrue(file != NULL && linkedListDump(d, file, LINKED_LIST_DUMP_BINARY) == 0
+		&& fileHolds(file, dumped, sizeof(dumped)), "binary dump");
+	fclose(file);
+	file = tmpfile();
+	assertTrue(file != NULL && linkedListDumpFd(d, fileno(file), LINKED_LIST_DUMP_TEXT) == 0
+		&& fileHolds(file, "-12\n0\n7\n100000\n", 15), "text dump to a descriptor");
+	fclose(file);
+	linkedListDestroy(d);
+	d = linkedListCreate();
+	file = tmpfile();
+	assertTrue(file != NULL && linkedListDump(d, file, LINKED_LIST_DUMP_TEXT) == 0
+		&& fileHolds(file, "", 0), "dump of an empty list");
+	fclose(file);
+	linkedListDestroy(d);
 	return 0;
 }
-
@@ -0,0 +1,32 @@
+/***********************************************************
+* Filename: linkedListSnapshot.c
+*
+* Overview:
+*   Snapshot files for LinkedList, built on the public interface
+*	so every engine shares them. A snapshot is a 32-byte header
+*	followed by the list's values from front to back, packed, in
+*	host byte order:
+*		magic		8 bytes, "DEQSNAP1"
+*		type		12 bytes, TYPE as spelled in the build (NUL padded)
+*		valueBytes	uint32_t, sizeof(TYPE)
+*		count		uint64_t, number of values
+*	circularListSnapshot.c writes the same format, so a snapshot
+*	of either deque loads into the other when TYPE matches. Both
+*	files are the same code: dequeTemplate.h's DEQUE_DEFINE_SNAPSHOT,
+*	instantiated for TYPE with external linkage.
+*
+*	linkedListSave writes the values with linkedListDump's binary
+*	mode. linkedListViewOpen maps a snapshot read-only and checks
+*	its header; the values can then be read in place without
+*	building a list. linkedListLoad opens a view and passes its
+*	values to linkedListCreateFromArray, so the list is built in one
+*	pass (carving every link from one block in linkedList.c).
+*
+* Usage:
+* 	gcc -g -Wall -std=c99 -c linkedListSnapshot.c
+************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include "linkedList.h"
+#include "../CLDeque/dequeTemplate.h"
+
+DEQUE_DEFINE_SNAPSHOT(LinkedList, linkedList, TYPE, )
@@ -0,0 +1,145 @@
+/***********************************************************
+* Filename: linkedListSortedMain.c
+*
+* Overview:
+*   Tests that a list made with linkedListCreateSorted stays in
+*	order when values come in through the deque, bulk and cursor
+*	adds, not only linkedListAdd. It is built with -DNDEBUG so the
+*	order has to hold without the engine's asserts. A run of random
+*	adds, cursor inserts and removes then checks the order and the
+*	range queries against a count of each value.
+*
+* Usage:
+* 	1) make -f makefileLLDequeBag sorted [ENGINE=...]
+*	2) ./sorted
+************************************************************/
+#include "linkedList.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define RANDOM_VALUES 64
+
+void assertTrue(int pred, char* msg)
+{
+	printf("%s: ", msg);
+	if(pred)
+		printf("\tPASSED\n");
+	else
+		printf("\tFAILED\n");
+}
+
+// Returns 1 if a cursor walk sees size values in LT order.
+int inOrder(struct LinkedList* list, int size)
+{
+	struct LinkedListCursor cursor;
+	int seen = 0;
+	int ok = 1;
+	TYPE last = 0;
+	for (linkedListCursorFront(list, &cursor); linkedListCursorValid(&cursor);
+		linkedListCursorNext(&cursor)) {
+		TYPE value = linkedListCursorGet(&cursor);
+		if (seen > 0 && LT(value, last)) ok = 0;
+		last = value;
+		seen++;
+	}
+	return ok && seen == size;
+}
+
+// Adds each value linkedListForEachRange visits to the int at arg.
+void sumVisit(TYPE value, void* arg)
+{
+	*(int*)arg += (int)value;
+}
+
+int main()
+{
+	struct LinkedList* list = linkedListCreateSorted();
+	for (int i = 0; i < 99; i++) {
+		linkedListAdd(list, (TYPE)i);
+	}
+	linkedListAddFront(list, (TYPE)1000);
+	linkedListAddBack(list, (TYPE)-5);
+	assertTrue(linkedListContains(list, (TYPE)1000), "contains value added to front");
+	assertTrue(linkedListContains(list, (TYPE)-5), "contains value added to back");
+	assertTrue(linkedListFront(list) == -5 && linkedListBack(list) == 1000,
+		"front == -5, back == 1000");
+	assertTrue(inOrder(list, 101), "in order after deque adds");
+
+	TYPE values[] = {500, -20, 50, 50, 7};
+	linkedListAddBackN(list, values, 5);
+	linkedListAddFrontN(list, values, 5);
+	assertTrue(inOrder(list, 111), "in order after bulk adds");
+	assertTrue(linkedListCountRange(list, (TYPE)50, (TYPE)51) == 5, "count of 50 == 5");
+	assertTrue(linkedListContains(list, (TYPE)500) && linkedListContains(list, (TYPE)-20),
+		"contains bulk-added values");
+
+	struct LinkedListCursor cursor;
+	linkedListCursorFront(list, &cursor);
+	linkedListCursorInsert(&cursor, (TYPE)2000);
+	linkedListCursorBack(list, &cursor);
+	linkedListCursorInsert(&cursor, (TYPE)-100);
+	assertTrue(linkedListCursorGet(&cursor) == 2000, "cursor stays on its value");
+	assertTrue(inOrder(list, 113), "in order after cursor inserts");
+	assertTrue(linkedListFront(list) == -100 && linkedListBack(list) == 2000,
+		"front == -100, back == 2000");
+
+	linkedListRemove(list, (TYPE)2000);
+	linkedListRemove(list, (TYPE)-100);
+	assertTrue(!linkedListContains(list, (TYPE)2000) && !linkedListContains(list, (TYPE)-100),
+		"removed values are gone");
+	assertTrue(inOrder(list, 111), "in order after removes");
+	linkedListDestroy(list);
+
+	//Random adds of every kind and removes against a count per value.
+	int counts[RANDOM_VALUES] = {0};
+	int size = 0;
+	int cursorKept = 1;
+	list = linkedListCreateSorted();
+	srand(16);
+	for (int step = 0; step < 5000; step++) {
+		TYPE value = (TYPE)(rand() % RANDOM_VALUES);
+		int op = rand() % 6;
+		if (op == 0) linkedListAddFront(list, value);
+		else if (op == 1) linkedListAddBack(list, value);
+		else if (op == 2) linkedListAdd(list, value);
+		else if (op == 3) {
+			TYPE pair[2] = {value, (TYPE)((value * 7 + 3) % RANDOM_VALUES)};
+			linkedListAddBackN(list, pair, 2);
+			counts[(int)pair[1]]++;
+			size++;
+		}
+		else if (op == 4 && size > 0) {
+			linkedListCursorBack(list, &cursor);
+			TYPE on = linkedListCursorGet(&cursor);
+			linkedListCursorInsert(&cursor, value);
+			if (linkedListCursorGet(&cursor) != on) cursorKept = 0;
+		}
+		else if (counts[(int)value] > 0) {
+			linkedListRemove(list, value);
+			counts[(int)value]--;
+			size--;
+			continue;
+		}
+		else {
+			continue;
+		}
+		counts[(int)value]++;
+		size++;
+	}
+	assertTrue(inOrder(list, size), "in order after random adds and removes");
+	assertTrue(cursorKept, "cursor stays on its value after sorted inserts");
+	int rangeOk = 1;
+	for (int lo = 0; lo < RANDOM_VALUES; lo += 5) {
+		int expected = 0, sum = 0, expectedSum = 0;
+		for (int v = lo; v < lo + 9 && v < RANDOM_VALUES; v++) {
+			expected += counts[v];
+			expectedSum += v * counts[v];
+		}
+		linkedListForEachRange(list, (TYPE)lo, (TYPE)(lo + 9), sumVisit, &sum);
+		if (linkedListCountRange(list, (TYPE)lo, (TYPE)(lo + 9)) != expected
+			|| sum != expectedSum) rangeOk = 0;
+	}
+	assertTrue(rangeOk, "range queries match the counts");
+	linkedListDestroy(list);
+	return 0;
+}
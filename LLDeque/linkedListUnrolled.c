@@ -0,0 +1,1242 @@
+/***********************************************************
+* Filename: linkedListUnrolled.c
+*
+* Overview:
+*   This program is an unrolled linked list implementation of
+*	the deque and bag ADTs declared in linkedList.h. It is a
+*	drop-in replacement for linkedList.c (see makefileLLDequeBag,
+*	ENGINE=linkedListUnrolled) and allows for the same behavior.
+*
+*	Instead of one value per link, every chunk holds an array of
+*	up to CHUNK_CAPACITY values (UNROLLED_CHUNK_BYTES per chunk,
+*	two cache lines by default) in the slots [start, end). Adding
+*	to the back fills the back chunk upwards and adding to the
+*	front fills the front chunk downwards; a new chunk is only
+*	linked in when the end chunk is full. Print, contains and
+*	remove scan the dense arrays.
+*
+*	The bulk functions copy whole runs of values into or out of
+*	each end chunk (memcpy where the order allows), so their cost
+*	is one chunk link per CHUNK_CAPACITY values.
+*
+*	Emptied chunks are kept on a spare list and reused; they are
+*	only freed when the list is destroyed. There is no hash index
+*	or skip list in this engine, so linkedListCreateHashed and
+*	linkedListCreateCounted return a plain list, and
+*	linkedListCount and the range queries scan every value. A list
+*	made with linkedListCreateSorted is kept in LT order by a
+*	linear insert: every add (deque, bulk, bag or cursor) skips the
+*	chunks whose last value is LT the new one and shifts it into
+*	the first chunk that is not, and the range queries stop at the
+*	first value past hi.
+*	There are no links to relink either, so linkedListSort merges
+*	values in place through a scratch array of size / 2 values.
+*	A cursor holds a chunk and a slot; stepping into a chunk
+*	prefetches the chunk after it, which covers the next
+*	CHUNK_CAPACITY values.
+*
+*	With -DCONTAINER_STATS the node counters in LinkedListStats
+*	count chunks rather than values.
+************************************************************/
+#include "linkedList.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef FORMAT_SPECIFIER
+#define FORMAT_SPECIFIER "%d"
+#endif
+
+#include "linkedListDump.h"
+
+#ifndef UNROLLED_CHUNK_BYTES
+#define UNROLLED_CHUNK_BYTES 128
+#endif
+
+#ifdef CONTAINER_STATS
+#define STAT(list, field, n) ((list)->stats.field += (n))
+#else
+#define STAT(list, field, n) ((void)0)
+#endif
+
+// Hint that a chunk will be read soon; cursors issue it for the chunk
+// after the one they step into (NO_PREFETCH turns it off).
+#if defined(__GNUC__) && !defined(NO_PREFETCH)
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p) ((void)(p))
+#endif
+
+#define CHUNK_CAPACITY ((int)((UNROLLED_CHUNK_BYTES - 2 * sizeof(void*) - 2 * sizeof(int)) / sizeof(TYPE)))
+
+// Double linked chunk of values
+struct Chunk
+{
+	struct Chunk* next;
+	struct Chunk* prev;
+	int start;
+	int end;
+	TYPE values[CHUNK_CAPACITY];
+};
+
+// Double linked list of chunks
+struct LinkedList
+{
+	struct Chunk* head;
+	struct Chunk* tail;
+	int size;
+	int sorted;				//1 if made with linkedListCreateSorted
+	struct Chunk* spare;	//unused chunks, chained through next
+#ifdef CONTAINER_STATS
+	struct LinkedListStats stats;
+#endif
+};
+
+// Position of one value in the chunk list
+struct Cursor
+{
+	struct Chunk* chunk;
+	int i;
+};
+
+/**
+	Takes a chunk off the spare list, or allocates one.
+	param: 	list 	struct LinkedList ptr
+	pre: 	list is not NULL
+	ret: 	chunk (never NULL); its fields are uninitialized
+ */
+static struct Chunk* allocChunk(struct LinkedList* list)
+{
+	struct Chunk* chunk = list->spare;
+	STAT(list, nodesAllocated, 1);
+	if (chunk != NULL) {
+		list->spare = chunk->next;
+		return chunk;
+	}
+	chunk = (struct Chunk*) malloc(sizeof(struct Chunk));
+	assert(chunk != 0);
+	STAT(list, bytesLive, (long)sizeof(struct Chunk));
+	return chunk;
+}
+
+/**
+	Unlinks the given chunk from the list and puts it on the spare list.
+	param: 	list 	struct LinkedList ptr
+	param: 	chunk 	struct Chunk ptr
+	pre: 	list and chunk are not NULL, chunk is in list
+	post: 	chunk is no longer in the list
+ */
+static void releaseChunk(struct LinkedList* list, struct Chunk* chunk)
+{
+	if (chunk->prev != NULL) chunk->prev->next = chunk->next;
+	else list->head = chunk->next;
+	if (chunk->next != NULL) chunk->next->prev = chunk->prev;
+	else list->tail = chunk->prev;
+	chunk->next = list->spare;
+	list->spare = chunk;
+	STAT(list, nodesFreed, 1);
+}
+
+/**
+	Links a new empty chunk in at the front or back of the list.
+	An empty chunk's start and end are placed at the edge that
+	will be filled: the top for a front chunk, 0 for a back chunk.
+	param: 	list 	struct LinkedList ptr
+	param: 	front 	int (1 = front, 0 = back)
+	pre: 	list is not NULL
+	post: 	new chunk is the list's head (front) or tail (back)
+	ret: 	new chunk
+ */
+static struct Chunk* pushChunk(struct LinkedList* list, int front)
+{
+	struct Chunk* chunk = allocChunk(list);
+	if (front) {
+		chunk->start = chunk->end = CHUNK_CAPACITY;
+		chunk->prev = NULL;
+		chunk->next = list->head;
+		if (list->head != NULL) list->head->prev = chunk;
+		else list->tail = chunk;
+		list->head = chunk;
+	}
+	else {
+		chunk->start = chunk->end = 0;
+		chunk->next = NULL;
+		chunk->prev = list->tail;
+		if (list->tail != NULL) list->tail->next = chunk;
+		else list->head = chunk;
+		list->tail = chunk;
+	}
+	return chunk;
+}
+
+/**
+	Moves all of chunk's next neighbour into chunk if both fit in one
+	chunk, so that bag removals do not leave a trail of sparse chunks.
+	param: 	list 	struct LinkedList ptr
+	param: 	chunk 	struct Chunk ptr
+	pre: 	list and chunk are not NULL, chunk is in list
+	post: 	chunk's next is merged into chunk if they fit
+ */
+static void mergeNext(struct LinkedList* list, struct Chunk* chunk)
+{
+	struct Chunk* next = chunk->next;
+	if (next == NULL) return;
+	int count = chunk->end - chunk->start;
+	int nextCount = next->end - next->start;
+	if (count + nextCount > CHUNK_CAPACITY) return;
+	memmove(chunk->values, chunk->values + chunk->start, count * sizeof(TYPE));
+	memcpy(chunk->values + count, next->values + next->start, nextCount * sizeof(TYPE));
+	chunk->start = 0;
+	chunk->end = count + nextCount;
+	releaseChunk(list, next);
+}
+
+/**
+	Stores value before the front value, linking in a new front
+	chunk if the current one has no free slot below start.
+	param: 	list 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	list is not NULL
+	post: 	value is the front value, size is incremented by 1
+ */
+static void addValueFront(struct LinkedList* list, TYPE value)
+{
+	struct Chunk* chunk = list->head;
+	if (chunk == NULL || chunk->start == 0) {
+		chunk = pushChunk(list, 1);
+	}
+	chunk->values[--chunk->start] = value;
+	list->size++;
+}
+
+/**
+	Stores value after the back value, linking in a new back chunk
+	if the current one has no free slot from end on.
+	param: 	list 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	list is not NULL
+	post: 	value is the back value, size is incremented by 1
+ */
+static void addValueBack(struct LinkedList* list, TYPE value)
+{
+	struct Chunk* chunk = list->tail;
+	if (chunk == NULL || chunk->end == CHUNK_CAPACITY) {
+		chunk = pushChunk(list, 0);
+	}
+	chunk->values[chunk->end++] = value;
+	list->size++;
+}
+
+/**
+	Stores value before the value at, shifting whichever part of its
+	chunk has room, or splitting a full chunk at at (the values from
+	at on go to a new chunk after it). keep, if not NULL, is a
+	position in the list that is moved to stay on the value it was
+	on; it may be at itself.
+	param: 	list 	struct LinkedList ptr
+	param: 	at 		struct Cursor ptr
+	param: 	value 	TYPE
+	param: 	keep 	struct Cursor ptr or NULL
+	pre: 	list is not NULL, at is on a value
+	post: 	value is before at's value, size is incremented by 1
+ */
+static void insertBefore(struct LinkedList* list, struct Cursor* at, TYPE value,
+	struct Cursor* keep)
+{
+	struct Chunk* chunk = at->chunk;
+	int i = at->i;
+	int moved = keep != NULL && keep->chunk == chunk;
+	if (chunk->start > 0) {
+		//Shift the values before at down a slot.
+		memmove(chunk->values + chunk->start - 1, chunk->values + chunk->start,
+			(i - chunk->start) * sizeof(TYPE));
+		chunk->start--;
+		chunk->values[i - 1] = value;
+		if (moved && keep->i < i) keep->i--;
+	}
+	else if (chunk->end < CHUNK_CAPACITY) {
+		//Shift at's value and the ones after it up a slot.
+		memmove(chunk->values + i + 1, chunk->values + i, (chunk->end - i) * sizeof(TYPE));
+		chunk->end++;
+		chunk->values[i] = value;
+		if (moved && keep->i >= i) keep->i++;
+	}
+	else {
+		//Split: the values from at on go to a new chunk after this one.
+		struct Chunk* rest = allocChunk(list);
+		rest->start = 0;
+		rest->end = chunk->end - i;
+		memcpy(rest->values, chunk->values + i, rest->end * sizeof(TYPE));
+		rest->prev = chunk;
+		rest->next = chunk->next;
+		if (chunk->next != NULL) chunk->next->prev = rest;
+		else list->tail = rest;
+		chunk->next = rest;
+		chunk->end = i + 1;
+		chunk->values[i] = value;
+		if (moved && keep->i >= i) {
+			keep->chunk = rest;
+			keep->i -= i;
+		}
+	}
+	list->size++;
+}
+
+/**
+	Adds a value to a sorted list before the first value that is not
+	LT it, so every kind of add keeps the order. Whole chunks whose
+	last value is LT it are skipped.
+	param: 	list 	struct LinkedList ptr
+	param: 	value 	TYPE
+	param: 	keep 	struct Cursor ptr or NULL (see insertBefore)
+	pre: 	list is sorted
+	post: 	value is in its sorted place
+ */
+static void addSorted(struct LinkedList* list, TYPE value, struct Cursor* keep)
+{
+	struct Chunk* chunk = list->head;
+	while (chunk != NULL && LT(chunk->values[chunk->end - 1], value)) {
+		STAT(list, nodesTraversed, 1);
+		chunk = chunk->next;
+	}
+	if (chunk == NULL) {
+		addValueBack(list, value);
+		return;
+	}
+	struct Cursor at = { chunk, chunk->start };
+	while (LT(chunk->values[at.i], value)) {
+		at.i++;
+	}
+	insertBefore(list, &at, value, keep);
+}
+
+/**
+	Allocates and initializes a list.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+			list has no chunks, size is 0
+	return: list
+ */
+struct LinkedList* linkedListCreate()
+{
+	struct LinkedList* list = malloc(sizeof(struct LinkedList));
+	assert(list != 0);
+	list->head = list->tail = NULL;
+	list->spare = NULL;
+	list->size = 0;
+	list->sorted = 0;
+#ifdef CONTAINER_STATS
+	struct LinkedListStats zero = {0};
+	list->stats = zero;
+	list->stats.bytesLive = sizeof(struct LinkedList);
+#endif
+	return list;
+}
+
+/**
+	Same as linkedListCreate; this engine has no hash index.
+ */
+struct LinkedList* linkedListCreateHashed()
+{
+	return linkedListCreate();
+}
+
+/**
+	Allocates a list that keeps its values in LT order. This engine
+	has no skip list, so every add is a linear ordered insert.
+	pre: 	none
+	post: 	memory allocated for new struct LinkedList ptr
+			list is empty and sorted
+	return: list
+ */
+struct LinkedList* linkedListCreateSorted()
+{
+	struct LinkedList* list = linkedListCreate();
+	list->sorted = 1;
+	return list;
+}
+
+/**
+	Same as linkedListCreate; duplicates are stored one per slot.
+ */
+struct LinkedList* linkedListCreateCounted()
+{
+	return linkedListCreate();
+}
+
+/**
+	Frees every chunk (in use or spare) and the list itself.
+	param:	list 	struct LinkedList ptr
+	pre: 	list is not NULL
+	post: 	memory allocated to each chunk is freed
+			" " list " "
+ */
+void linkedListDestroy(struct LinkedList* list)
+{
+	assert(list != NULL);
+	struct Chunk* chunk = list->head;
+	while (chunk != NULL) {
+		struct Chunk* next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+	chunk = list->spare;
+	while (chunk != NULL) {
+		struct Chunk* next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+	free(list);
+}
+
+/**
+	Makes sure the list can hold n more values without allocating.
+	Free slots in the end chunks are not counted, so this may
+	allocate up to one chunk more than strictly needed.
+	param:	list 	struct LinkedList ptr
+	param:	n 		int
+	pre: 	list is not NULL, n >= 0
+	post: 	spare list has at least ceil(n / CHUNK_CAPACITY) chunks
+ */
+void linkedListReserve(struct LinkedList* list, int n)
+{
+	assert(list != NULL && n >= 0);
+	int needed = (n + CHUNK_CAPACITY - 1) / CHUNK_CAPACITY;
+	struct Chunk* chunk = list->spare;
+	while (chunk != NULL && needed > 0) {
+		needed--;
+		chunk = chunk->next;
+	}
+	while (needed-- > 0) {
+		chunk = (struct Chunk*) malloc(sizeof(struct Chunk));
+		assert(chunk != 0);
+		STAT(list, bytesLive, (long)sizeof(struct Chunk));
+		chunk->next = list->spare;
+		list->spare = chunk;
+	}
+}
+
+/**
+	Adds the given value to the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not NULL
+	post: 	value is stored before the current front value; in a
+			sorted list it goes in its sorted place instead
+ */
+void linkedListAddFront(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != NULL);
+	STAT(deque, addFront, 1);
+	if (deque->sorted)
+		addSorted(deque, value, NULL);
+	else
+		addValueFront(deque, value);
+}
+
+/**
+	Adds the given value to the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	deque is not NULL
+	post: 	value is stored after the current back value; in a
+			sorted list it goes in its sorted place instead
+ */
+void linkedListAddBack(struct LinkedList* deque, TYPE value)
+{
+	assert(deque != NULL);
+	STAT(deque, addBack, 1);
+	if (deque->sorted)
+		addSorted(deque, value, NULL);
+	else
+		addValueBack(deque, value);
+}
+
+/**
+	Returns the value at the front of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not NULL
+	pre:	deque is not empty
+	post:	none
+	ret:	front value
+ */
+TYPE linkedListFront(struct LinkedList* deque)
+{
+	assert(deque != NULL && deque->size != 0);
+	STAT(deque, front, 1);
+	return deque->head->values[deque->head->start];
+}
+
+/**
+	Returns the value at the back of the deque.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not NULL
+	pre:	deque is not empty
+	post:	none
+	ret:	back value
+ */
+TYPE linkedListBack(struct LinkedList* deque)
+{
+	assert(deque != NULL && deque->size != 0);
+	STAT(deque, back, 1);
+	return deque->tail->values[deque->tail->end - 1];
+}
+
+/**
+	Removes the value at the front of the deque, releasing the front
+	chunk once it is drained.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not NULL
+	pre:	deque is not empty
+	post:	front value is removed
+ */
+void linkedListRemoveFront(struct LinkedList* deque)
+{
+	assert(deque != NULL && deque->size != 0);
+	STAT(deque, removeFront, 1);
+	struct Chunk* chunk = deque->head;
+	chunk->start++;
+	if (chunk->start == chunk->end) {
+		releaseChunk(deque, chunk);
+	}
+	deque->size--;
+}
+
+/**
+	Removes the value at the back of the deque, releasing the back
+	chunk once it is drained.
+	param: 	deque 	struct LinkedList ptr
+	pre:	deque is not NULL
+	pre:	deque is not empty
+	post:	back value is removed
+ */
+void linkedListRemoveBack(struct LinkedList* deque)
+{
+	assert(deque != NULL && deque->size != 0);
+	STAT(deque, removeBack, 1);
+	struct Chunk* chunk = deque->tail;
+	chunk->end--;
+	if (chunk->start == chunk->end) {
+		releaseChunk(deque, chunk);
+	}
+	deque->size--;
+}
+
+/**
+	Allocates a list holding the given values, values[0] at the front.
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	pre: 	values is not NULL unless n is 0, n >= 0
+	post: 	memory allocated for new struct LinkedList ptr
+			list holds the n values in order
+	return: list
+ */
+struct LinkedList* linkedListCreateFromArray(const TYPE* values, int n)
+{
+	struct LinkedList* list = linkedListCreate();
+	linkedListAddBackN(list, values, n);
+	return list;
+}
+
+/**
+	Adds n values to the back of the deque, in order, so values[n - 1]
+	ends up at the back (same result as n calls to linkedListAddBack).
+	param: 	deque 	struct LinkedList ptr
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	pre:	values is not NULL unless n is 0
+	post: 	values are stored after the current back value; in a
+			sorted list each one goes in its sorted place instead
+ */
+void linkedListAddBackN(struct LinkedList* deque, const TYPE* values, int n)
+{
+	assert(deque != NULL && n >= 0);
+	assert(values != NULL || n == 0);
+	STAT(deque, addBack, n);
+	linkedListReserve(deque, n);
+	if (deque->sorted) {
+		for (int i = 0; i < n; i++) {
+			addSorted(deque, values[i], NULL);
+		}
+		return;
+	}
+	int i = 0;
+	while (i < n) {
+		struct Chunk* chunk = deque->tail;
+		if (chunk == NULL || chunk->end == CHUNK_CAPACITY) {
+			chunk = pushChunk(deque, 0);
+		}
+		int k = CHUNK_CAPACITY - chunk->end;
+		if (k > n - i) k = n - i;
+		memcpy(chunk->values + chunk->end, values + i, k * sizeof(TYPE));
+		chunk->end += k;
+		i += k;
+	}
+	deque->size += n;
+}
+
+/**
+	Adds n values to the front of the deque, one after the other, so
+	values[n - 1] ends up at the front (same result as n calls to
+	linkedListAddFront).
+	param: 	deque 	struct LinkedList ptr
+	param: 	values 	const TYPE ptr
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	pre:	values is not NULL unless n is 0
+	post: 	values are stored before the current front value; in a
+			sorted list each one goes in its sorted place instead
+ */
+void linkedListAddFrontN(struct LinkedList* deque, const TYPE* values, int n)
+{
+	assert(deque != NULL && n >= 0);
+	assert(values != NULL || n == 0);
+	STAT(deque, addFront, n);
+	linkedListReserve(deque, n);
+	if (deque->sorted) {
+		for (int i = 0; i < n; i++) {
+			addSorted(deque, values[i], NULL);
+		}
+		return;
+	}
+	int i = 0;
+	while (i < n) {
+		struct Chunk* chunk = deque->head;
+		if (chunk == NULL || chunk->start == 0) {
+			chunk = pushChunk(deque, 1);
+		}
+		int k = chunk->start;
+		if (k > n - i) k = n - i;
+		for (int j = 0; j < k; j++) {
+			chunk->values[--chunk->start] = values[i++];
+		}
+	}
+	deque->size += n;
+}
+
+/**
+	Removes up to n values from the front of the deque and copies them
+	out, front value first, releasing each chunk once it is drained.
+	param: 	deque 	struct LinkedList ptr
+	param: 	out 	TYPE ptr, room for n values (or NULL to drop them)
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	post: 	the first min(n, size) values are removed
+	ret: 	number of values removed
+ */
+int linkedListRemoveFrontN(struct LinkedList* deque, TYPE* out, int n)
+{
+	assert(deque != NULL && n >= 0);
+	if (n > deque->size) n = deque->size;
+	STAT(deque, removeFront, n);
+	int i = 0;
+	while (i < n) {
+		struct Chunk* chunk = deque->head;
+		int k = chunk->end - chunk->start;
+		if (k > n - i) k = n - i;
+		if (out != NULL) {
+			memcpy(out + i, chunk->values + chunk->start, k * sizeof(TYPE));
+		}
+		chunk->start += k;
+		i += k;
+		if (chunk->start == chunk->end) {
+			releaseChunk(deque, chunk);
+		}
+	}
+	deque->size -= n;
+	return n;
+}
+
+/**
+	Removes up to n values from the back of the deque and copies them
+	out, back value first, releasing each chunk once it is drained.
+	param: 	deque 	struct LinkedList ptr
+	param: 	out 	TYPE ptr, room for n values (or NULL to drop them)
+	param: 	n 		int
+	pre: 	deque is not NULL, n >= 0
+	post: 	the last min(n, size) values are removed
+	ret: 	number of values removed
+ */
+int linkedListRemoveBackN(struct LinkedList* deque, TYPE* out, int n)
+{
+	assert(deque != NULL && n >= 0);
+	if (n > deque->size) n = deque->size;
+	STAT(deque, removeBack, n);
+	int i = 0;
+	while (i < n) {
+		struct Chunk* chunk = deque->tail;
+		int k = chunk->end - chunk->start;
+		if (k > n - i) k = n - i;
+		for (int j = 0; j < k; j++) {
+			TYPE value = chunk->values[--chunk->end];
+			if (out != NULL) out[i] = value;
+			i++;
+		}
+		if (chunk->start == chunk->end) {
+			releaseChunk(deque, chunk);
+		}
+	}
+	deque->size -= n;
+	return n;
+}
+
+/**
+	Returns 1 if the deque is empty and 0 otherwise.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not NULL
+	post:	none
+	ret:	1 if its size is 0 (empty), otherwise 0 (not empty)
+ */
+int linkedListIsEmpty(struct LinkedList* deque)
+{
+	assert(deque != NULL);
+	if(deque->size == 0) return 1; //True
+	return 0; //False
+}
+
+/**
+	Adds every value of the deque to buffer, from front to back.
+	param:	deque	struct LinkedList ptr
+	param:	buffer	struct DequeDump ptr
+	pre:	deque is not NULL, buffer was opened
+ */
+static void dumpValues(struct LinkedList* deque, struct DequeDump* buffer)
+{
+	for (struct Chunk* chunk = deque->head; chunk != NULL; chunk = chunk->next) {
+		for (int i = chunk->start; i < chunk->end; i++) {
+			dumpValue(buffer, chunk->values[i]);
+		}
+	}
+}
+
+/**
+	Writes the values in the deque from front to back to out.
+	param:	deque	struct LinkedList ptr
+	param:	out		FILE ptr
+	param:	mode	LINKED_LIST_DUMP_TEXT or LINKED_LIST_DUMP_BINARY
+	pre:	deque and out are not NULL
+	ret:	0 if every write succeeded; otherwise, -1
+ */
+int linkedListDump(struct LinkedList* deque, FILE* out, int mode)
+{
+	assert(deque != NULL && out != NULL);
+	struct DequeDump buffer;
+	dequeDumpOpen(&buffer, out, -1, mode);
+	dumpValues(deque, &buffer);
+	return dequeDumpClose(&buffer);
+}
+
+/**
+	Writes the values in the deque from front to back to the file
+	descriptor fd.
+	param:	deque	struct LinkedList ptr
+	param:	fd		int
+	param:	mode	LINKED_LIST_DUMP_TEXT or LINKED_LIST_DUMP_BINARY
+	pre:	deque is not NULL, fd is open for writing
+	ret:	0 if every write succeeded; otherwise, -1 (errno is set)
+ */
+int linkedListDumpFd(struct LinkedList* deque, int fd, int mode)
+{
+	assert(deque != NULL);
+	struct DequeDump buffer;
+	dequeDumpOpen(&buffer, NULL, fd, mode);
+	dumpValues(deque, &buffer);
+	return dequeDumpClose(&buffer);
+}
+
+/**
+	Prints the values in the deque from front to back, one per line.
+	param:	deque	struct LinkedList ptr
+	pre:	deque is not NULL
+	ret:	outputs to the console the values from front to back
+ */
+void linkedListPrint(struct LinkedList* deque)
+{
+	linkedListDump(deque, stdout, LINKED_LIST_DUMP_TEXT);
+}
+
+/**
+	Moves the cursor to the next value, stepping into the next
+	chunk at the end of this one.
+	param: 	at 	struct Cursor ptr
+	pre: 	at is on a value
+	post: 	at is on the next value (chunk NULL past the back)
+ */
+static void cursorNext(struct Cursor* at)
+{
+	if (++at->i == at->chunk->end) {
+		at->chunk = at->chunk->next;
+		if (at->chunk != NULL) at->i = at->chunk->start;
+	}
+}
+
+/**
+	Moves the cursor to the previous value, stepping into the
+	previous chunk at the start of this one.
+	param: 	at 	struct Cursor ptr
+	pre: 	at is on a value that is not the front value
+	post: 	at is on the previous value
+ */
+static void cursorPrev(struct Cursor* at)
+{
+	if (at->i == at->chunk->start) {
+		at->chunk = at->chunk->prev;
+		at->i = at->chunk->end;
+	}
+	at->i--;
+}
+
+/**
+	Sorts the list by LT in O(n log n) with a stable bottom-up merge
+	sort over the values in place. The values live in chunks rather
+	than in links that could be relinked, so each merge copies its
+	shorter run into one scratch array of size / 2 values and merges
+	it with the other run back into the chunks (ties take the left
+	run).
+	The chunks themselves are not moved or reallocated. A sorted
+	list is already in order.
+	param: 	list 	struct LinkedList ptr
+	pre: 	list is not NULL
+	post: 	values are in LT order from front to back; equal values
+			keep their relative order
+ */
+void linkedListSort(struct LinkedList* list)
+{
+	assert(list != NULL);
+	if (list->size < 2 || list->sorted) return;
+	TYPE* scratch = malloc((list->size / 2) * sizeof(TYPE));
+	assert(scratch != 0);
+	for (int width = 1; width < list->size; width *= 2) {
+		struct Cursor out = { list->head, list->head->start };
+		for (int lo = 0; lo + width < list->size; lo += 2 * width) {
+			int leftSize = width;
+			int rightSize = list->size - lo - width < width ? list->size - lo - width : width;
+			if (rightSize < leftSize) {
+				//Only the last, short pair: copy the right run out and
+				//merge from the back (ties take the right run).
+				struct Cursor left = out;
+				for (int k = 0; k < leftSize; k++) {
+					cursorNext(&left);
+				}
+				struct Cursor back = left;
+				for (int k = 0; k < rightSize; k++) {
+					back = left;
+					scratch[k] = left.chunk->values[left.i];
+					cursorNext(&left);
+				}
+				left = out;
+				for (int k = 1; k < leftSize; k++) {
+					cursorNext(&left);
+				}
+				int a = leftSize, b = rightSize;
+				while (b > 0) {
+					if (a > 0 && LT(scratch[b - 1], left.chunk->values[left.i])) {
+						back.chunk->values[back.i] = left.chunk->values[left.i];
+						if (--a > 0) cursorPrev(&left);
+					}
+					else {
+						back.chunk->values[back.i] = scratch[--b];
+					}
+					if (b > 0) cursorPrev(&back);
+				}
+				break;
+			}
+			//Copy the left run out; in is then at the right run.
+			struct Cursor in = out;
+			for (int k = 0; k < leftSize; k++) {
+				scratch[k] = in.chunk->values[in.i];
+				cursorNext(&in);
+			}
+			//out trails in by the left values not yet merged.
+			int a = 0, b = 0;
+			while (a < leftSize) {
+				if (b < rightSize && LT(in.chunk->values[in.i], scratch[a])) {
+					out.chunk->values[out.i] = in.chunk->values[in.i];
+					cursorNext(&in);
+					b++;
+				}
+				else {
+					out.chunk->values[out.i] = scratch[a++];
+				}
+				cursorNext(&out);
+			}
+			//The rest of the right run is already in place.
+			for (; b < rightSize; b++) {
+				cursorNext(&in);
+			}
+			out = in;
+		}
+	}
+	free(scratch);
+}
+
+#ifdef CONTAINER_STATS
+/**
+	Copies the list's operation counters into stats.
+	param:	list	struct LinkedList ptr
+	param:	stats	struct LinkedListStats ptr
+	pre:	list and stats are not NULL
+	post:	stats holds the counts since the list was created
+ */
+void linkedListGetStats(struct LinkedList* list, struct LinkedListStats* stats)
+{
+	assert(list != NULL && stats != NULL);
+	*stats = list->stats;
+}
+#endif
+
+////////////////BAG/////////////////BAG///////////BAG////////////////
+/**
+	Adds the given value to the bag (at the front, like linkedList.c,
+	or in its sorted place in a sorted list).
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not NULL
+	post: 	value is in the bag
+ */
+void linkedListAdd(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != NULL);
+	STAT(bag, add, 1);
+	if (bag->sorted)
+		addSorted(bag, value, NULL);
+	else
+		addValueFront(bag, value);
+}
+
+/**
+	Returns 1 if the value is in the bag and 0 otherwise.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not NULL
+	post:	none
+	ret:	1 if value found; otherwise, 0
+ */
+int linkedListContains(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != NULL);
+	STAT(bag, contains, 1);
+	for (struct Chunk* chunk = bag->head; chunk != NULL; chunk = chunk->next) {
+		STAT(bag, nodesTraversed, 1);
+		for (int i = chunk->start; i < chunk->end; i++) {
+			if (EQ(chunk->values[i], value)) return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+	Removes the first occurrence of the given value. The rest of its
+	chunk is shifted down to close the gap, and the chunk is merged
+	with a neighbour when the two fit in one chunk.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not NULL
+	pre:	bag is not empty
+	post:	if value found, one occurrence is removed
+ */
+void linkedListRemove(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != NULL);
+	assert(!linkedListIsEmpty(bag));
+	STAT(bag, remove, 1);
+	for (struct Chunk* chunk = bag->head; chunk != NULL; chunk = chunk->next) {
+		STAT(bag, nodesTraversed, 1);
+		for (int i = chunk->start; i < chunk->end; i++) {
+			if (EQ(chunk->values[i], value)) {
+				memmove(chunk->values + i, chunk->values + i + 1,
+					(chunk->end - i - 1) * sizeof(TYPE));
+				chunk->end--;
+				bag->size--;
+				if (chunk->start == chunk->end) {
+					releaseChunk(bag, chunk);
+				}
+				else if (chunk->prev != NULL) {
+					mergeNext(bag, chunk->prev);
+				}
+				else {
+					mergeNext(bag, chunk);
+				}
+				return;
+			}
+		}
+	}
+}
+
+/**
+	Returns the number of times the value is in the bag, scanning
+	every value.
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	pre: 	bag is not NULL
+	post:	none
+	ret:	occurrences of value
+ */
+int linkedListCount(struct LinkedList* bag, TYPE value)
+{
+	assert(bag != NULL);
+	STAT(bag, contains, 1);
+	int count = 0;
+	for (struct Chunk* chunk = bag->head; chunk != NULL; chunk = chunk->next) {
+		STAT(bag, nodesTraversed, 1);
+		for (int i = chunk->start; i < chunk->end; i++) {
+			if (EQ(chunk->values[i], value)) count++;
+		}
+	}
+	return count;
+}
+
+/**
+	Adds n occurrences of the value to the front of the bag (same
+	result as n calls to linkedListAdd).
+	param:	bag		struct LinkedList ptr
+	param: 	value 	TYPE
+	param: 	n 		int
+	pre: 	bag is not NULL, n >= 0
+	post: 	value is in the bag n more times
+ */
+void linkedListAddMany(struct LinkedList* bag, TYPE value, int n)
+{
+	assert(bag != NULL && n >= 0);
+	STAT(bag, add, n);
+	for (int i = 0; i < n; i++) {
+		if (bag->sorted)
+			addSorted(bag, value, NULL);
+		else
+			addValueFront(bag, value);
+	}
+}
+
+/**
+	Returns the number of values v in the bag with lo <= v < hi
+	(by LT), scanning every value (up to the first one past hi in a
+	sorted list).
+	param:	bag		struct LinkedList ptr
+	param: 	lo 		TYPE
+	param: 	hi 		TYPE
+	pre: 	bag is not NULL
+	post:	none
+	ret:	number of values in [lo, hi)
+ */
+int linkedListCountRange(struct LinkedList* bag, TYPE lo, TYPE hi)
+{
+	assert(bag != NULL);
+	int count = 0;
+	for (struct Chunk* chunk = bag->head; chunk != NULL; chunk = chunk->next) {
+		STAT(bag, nodesTraversed, 1);
+		for (int i = chunk->start; i < chunk->end; i++) {
+			if (!LT(chunk->values[i], hi)) {
+				if (bag->sorted) return count;
+				continue;
+			}
+			if (!LT(chunk->values[i], lo)) count++;
+		}
+	}
+	return count;
+}
+
+/**
+	Calls visit(v, arg) for every value v in the bag with lo <= v < hi
+	(by LT), front to back, scanning every value (up to the first
+	one past hi in a sorted list).
+	param:	bag		struct LinkedList ptr
+	param: 	lo 		TYPE
+	param: 	hi 		TYPE
+	param: 	visit 	function called with each value and arg
+	param: 	arg 	void ptr passed through to visit
+	pre: 	bag and visit are not NULL
+	pre:	visit does not change the bag
+ */
+void linkedListForEachRange(struct LinkedList* bag, TYPE lo, TYPE hi,
+	void (*visit)(TYPE value, void* arg), void* arg)
+{
+	assert(bag != NULL && visit != NULL);
+	for (struct Chunk* chunk = bag->head; chunk != NULL; chunk = chunk->next) {
+		STAT(bag, nodesTraversed, 1);
+		for (int i = chunk->start; i < chunk->end; i++) {
+			if (!LT(chunk->values[i], hi)) {
+				if (bag->sorted) return;
+				continue;
+			}
+			if (!LT(chunk->values[i], lo)) visit(chunk->values[i], arg);
+		}
+	}
+}
+
+////////////////CURSOR//////////////CURSOR////////CURSOR/////////////
+/**
+	Puts the cursor on the front value of the list (past the back if
+	the list is empty).
+	param:	list	struct LinkedList ptr
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	list and cursor are not NULL
+	post:	cursor is on the head chunk's first slot
+ */
+void linkedListCursorFront(struct LinkedList* list, struct LinkedListCursor* cursor)
+{
+	assert(list != NULL && cursor != NULL);
+	struct Chunk* chunk = list->head;
+	cursor->list = list;
+	cursor->node = chunk;
+	if (chunk != NULL) {
+		PREFETCH(chunk->next);
+		cursor->index = chunk->start;
+	}
+}
+
+/**
+	Puts the cursor on the back value of the list (past the front if
+	the list is empty).
+	param:	list	struct LinkedList ptr
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	list and cursor are not NULL
+	post:	cursor is on the tail chunk's last slot
+ */
+void linkedListCursorBack(struct LinkedList* list, struct LinkedListCursor* cursor)
+{
+	assert(list != NULL && cursor != NULL);
+	struct Chunk* chunk = list->tail;
+	cursor->list = list;
+	cursor->node = chunk;
+	if (chunk != NULL) {
+		PREFETCH(chunk->prev);
+		cursor->index = chunk->end - 1;
+	}
+}
+
+/**
+	Returns 1 if the cursor is on a value and 0 if it is past either end.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor was set by linkedListCursorFront/Back
+	ret:	1 if on a value; otherwise, 0
+ */
+int linkedListCursorValid(struct LinkedListCursor* cursor)
+{
+	assert(cursor != NULL);
+	return cursor->node != NULL;
+}
+
+/**
+	Moves the cursor to the next value, stepping into the next chunk
+	(and prefetching the one after it) at the end of this one.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	post:	cursor is on the next value (past the back after the last)
+ */
+void linkedListCursorNext(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	struct Chunk* chunk = cursor->node;
+	if (++cursor->index == chunk->end) {
+		chunk = chunk->next;
+		cursor->node = chunk;
+		if (chunk != NULL) {
+			PREFETCH(chunk->next);
+			cursor->index = chunk->start;
+		}
+	}
+}
+
+/**
+	Moves the cursor to the previous value, stepping into the previous
+	chunk (and prefetching the one before it) at the start of this one.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	post:	cursor is on the previous value (past the front after the first)
+ */
+void linkedListCursorPrev(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	struct Chunk* chunk = cursor->node;
+	if (cursor->index-- == chunk->start) {
+		chunk = chunk->prev;
+		cursor->node = chunk;
+		if (chunk != NULL) {
+			PREFETCH(chunk->prev);
+			cursor->index = chunk->end - 1;
+		}
+	}
+}
+
+/**
+	Returns the value the cursor is on.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	ret:	value in the cursor's slot
+ */
+TYPE linkedListCursorGet(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	return ((struct Chunk*)cursor->node)->values[cursor->index];
+}
+
+/**
+	Removes the value the cursor is on and moves the cursor to the
+	next one. The rest of the chunk is shifted down to close the gap
+	and, as in linkedListRemove, the chunk is merged with its next
+	neighbour when the two fit in one chunk. Other cursors on the
+	chunk (or on its merged neighbour) become invalid.
+	param:	cursor	struct LinkedListCursor ptr
+	pre:	cursor is on a value
+	post:	one value is removed, cursor is on the value after it
+ */
+void linkedListCursorErase(struct LinkedListCursor* cursor)
+{
+	assert(linkedListCursorValid(cursor));
+	struct LinkedList* list = cursor->list;
+	struct Chunk* chunk = cursor->node;
+	int i = cursor->index;
+	memmove(chunk->values + i, chunk->values + i + 1, (chunk->end - i - 1) * sizeof(TYPE));
+	chunk->end--;
+	list->size--;
+	struct Chunk* next = chunk->next;
+	if (chunk->start == chunk->end) {
+		releaseChunk(list, chunk);
+		cursor->node = next;
+		if (next != NULL) cursor->index = next->start;
+		return;
+	}
+	int offset = i - chunk->start;
+	int count = chunk->end - chunk->start;
+	if (next != NULL && count + (next->end - next->start) <= CHUNK_CAPACITY) {
+		//mergeNext moves chunk's values to slot 0 and next's after them.
+		mergeNext(list, chunk);
+		cursor->index = offset;
+	}
+	else if (offset == count) {
+		cursor->node = next;
+		if (next != NULL) cursor->index = next->start;
+	}
+}
+
+/**
+	Adds the value before the one the cursor is on, or at the back if
+	the cursor is past either end; the cursor stays on its value. A
+	full chunk is split at the cursor, and the cursor moves with its
+	half. In a sorted list the value goes in its sorted place instead,
+	and the cursor still stays on its value.
+	param:	cursor	struct LinkedListCursor ptr
+	param: 	value 	TYPE
+	pre:	cursor was set by linkedListCursorFront/Back
+	post:	value is before the cursor's value (or in its sorted place)
+ */
+void linkedListCursorInsert(struct LinkedListCursor* cursor, TYPE value)
+{
+	assert(cursor != NULL);
+	struct LinkedList* list = cursor->list;
+	struct Cursor at = { cursor->node, cursor->index };
+	if (list->sorted) {
+		addSorted(list, value, at.chunk != NULL ? &at : NULL);
+	}
+	else if (at.chunk == NULL) {
+		linkedListAddBack(list, value);
+		return;
+	}
+	else {
+		insertBefore(list, &at, value, &at);
+	}
+	cursor->node = at.chunk;
+	cursor->index = at.i;
+}
@@ -0,0 +1,330 @@
+/***********************************************************
+* Filename: boundedQueue.c
+*
+* Overview:
+*   This program is a bounded, blocking version of the singly
+*	linked queue from stack_from_queue.c, for handing values
+*	between pipeline stages. A full queue holds producers back
+*	(backpressure) instead of growing without limit.
+*	It allows for the following behavior:
+*		- adding a value to the back, waiting while the queue is
+*		  full (or until a timeout)
+*		- removing the front value, waiting while the queue is
+*		  empty (or until a timeout)
+*		- removing up to n values at once
+*		- closing the queue: adds fail from then on, and removes
+*		  return what is left before reporting the queue closed
+*
+*	The values live in a struct Queue guarded by one pthread mutex.
+*	Producers wait on notFull and consumers on notEmpty. Each side
+*	counts its waiting threads, so a call only signals when someone
+*	is waiting. A batch remove takes up to n values under one lock
+*	acquisition and signals notFull once per freed slot, up to the
+*	number of waiting producers, so it wakes no more producers than
+*	can add.
+*	Timed waits use CLOCK_MONOTONIC, so changing the wall clock
+*	does not stretch or cut them short.
+*
+* Usage:
+* 	gcc -g -Wall -std=c99 -pthread -c boundedQueue.c
+*	(link with stack_from_queue.c built with -DSTACK_FROM_QUEUE_NO_MAIN)
+************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include "boundedQueue.h"
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+struct BoundedQueue {
+	struct Queue* queue;
+	int size;
+	int capacity;
+	int closed;
+	int waitingProducers;	//threads blocked in an add
+	int waitingConsumers;	//" " a remove
+	pthread_mutex_t lock;
+	pthread_cond_t notFull;
+	pthread_cond_t notEmpty;
+};
+
+/**
+	Allocates and initializes an empty queue.
+	param: 	capacity 	int, most values the queue holds at once
+	pre: 	capacity > 0
+	post: 	memory allocated for new struct BoundedQueue ptr
+	return: queue
+ */
+struct BoundedQueue* boundedQueueCreate(int capacity)
+{
+	assert(capacity > 0);
+	struct BoundedQueue* queue = malloc(sizeof(struct BoundedQueue));
+	assert(queue != NULL);
+	queue->queue = listQueueCreate();
+	queue->size = 0;
+	queue->capacity = capacity;
+	queue->closed = 0;
+	queue->waitingProducers = 0;
+	queue->waitingConsumers = 0;
+	pthread_mutex_init(&queue->lock, NULL);
+	pthread_condattr_t attr;
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&queue->notFull, &attr);
+	pthread_cond_init(&queue->notEmpty, &attr);
+	pthread_condattr_destroy(&attr);
+	return queue;
+}
+
+/**
+	Frees the values still queued and the queue itself.
+	param:	queue 	struct BoundedQueue ptr
+	pre: 	queue is not null, no other thread is using it
+	post: 	memory allocated to the queue is freed
+ */
+void boundedQueueDestroy(struct BoundedQueue* queue)
+{
+	assert(queue != NULL);
+	listQueueDestroy(queue->queue);
+	pthread_mutex_destroy(&queue->lock);
+	pthread_cond_destroy(&queue->notFull);
+	pthread_cond_destroy(&queue->notEmpty);
+	free(queue);
+}
+
+/**
+	Sets deadline to timeoutMs milliseconds from now.
+	param: 	deadline 	struct timespec ptr
+	param: 	timeoutMs 	long
+	pre: 	deadline is not null, timeoutMs >= 0
+ */
+static void deadlineAfter(struct timespec* deadline, long timeoutMs)
+{
+	clock_gettime(CLOCK_MONOTONIC, deadline);
+	deadline->tv_sec += timeoutMs / 1000;
+	deadline->tv_nsec += (timeoutMs % 1000) * 1000000L;
+	if (deadline->tv_nsec >= 1000000000L) {
+		deadline->tv_sec += 1;
+		deadline->tv_nsec -= 1000000000L;
+	}
+}
+
+/**
+	Waits on cond, counting the caller in waiting meanwhile.
+	param: 	queue 		struct BoundedQueue ptr
+	param: 	cond 		pthread_cond_t ptr, notFull or notEmpty
+	param: 	waiting 	int ptr, the matching waiting count
+	param: 	deadline 	const struct timespec ptr, NULL to wait forever
+	pre: 	the caller holds queue's lock
+	ret: 	0, or ETIMEDOUT once deadline has passed
+ */
+static int waitOn(struct BoundedQueue* queue, pthread_cond_t* cond, int* waiting,
+	const struct timespec* deadline)
+{
+	int result = 0;
+	*waiting += 1;
+	if (deadline == NULL) {
+		pthread_cond_wait(cond, &queue->lock);
+	}
+	else {
+		result = pthread_cond_timedwait(cond, &queue->lock, deadline);
+	}
+	*waiting -= 1;
+	return result;
+}
+
+/**
+	Adds value to the back of the queue once there is room.
+	param: 	queue 		struct BoundedQueue ptr
+	param: 	value 		TYPE
+	param: 	deadline 	const struct timespec ptr, NULL to wait forever
+	pre: 	queue is not null
+	ret: 	BOUNDED_QUEUE_OK, BOUNDED_QUEUE_CLOSED or BOUNDED_QUEUE_TIMEOUT
+ */
+static int addBack(struct BoundedQueue* queue, TYPE value, const struct timespec* deadline)
+{
+	assert(queue != NULL);
+	pthread_mutex_lock(&queue->lock);
+	while (!queue->closed && queue->size == queue->capacity) {
+		if (waitOn(queue, &queue->notFull, &queue->waitingProducers, deadline) == ETIMEDOUT
+			&& !queue->closed && queue->size == queue->capacity) {
+			pthread_mutex_unlock(&queue->lock);
+			return BOUNDED_QUEUE_TIMEOUT;
+		}
+	}
+	if (queue->closed) {
+		pthread_mutex_unlock(&queue->lock);
+		return BOUNDED_QUEUE_CLOSED;
+	}
+	listQueueAddBack(queue->queue, value);
+	queue->size += 1;
+	if (queue->waitingConsumers > 0) {
+		pthread_cond_signal(&queue->notEmpty);
+	}
+	pthread_mutex_unlock(&queue->lock);
+	return BOUNDED_QUEUE_OK;
+}
+
+/**
+	Removes up to n values from the front of the queue once it holds
+	any, in one lock acquisition.
+	param: 	queue 		struct BoundedQueue ptr
+	param: 	out 		TYPE ptr, room for n values
+	param: 	n 			int
+	param: 	deadline 	const struct timespec ptr, NULL to wait forever
+	pre: 	queue and out are not null, n > 0
+	ret: 	number of values removed (0 once the queue is closed and
+			empty), or BOUNDED_QUEUE_TIMEOUT
+ */
+static int removeFront(struct BoundedQueue* queue, TYPE* out, int n,
+	const struct timespec* deadline)
+{
+	assert(queue != NULL && out != NULL && n > 0);
+	pthread_mutex_lock(&queue->lock);
+	while (!queue->closed && queue->size == 0) {
+		if (waitOn(queue, &queue->notEmpty, &queue->waitingConsumers, deadline) == ETIMEDOUT
+			&& !queue->closed && queue->size == 0) {
+			pthread_mutex_unlock(&queue->lock);
+			return BOUNDED_QUEUE_TIMEOUT;
+		}
+	}
+	int k = n < queue->size ? n : queue->size;
+	for (int i = 0; i < k; i++) {
+		out[i] = listQueueRemoveFront(queue->queue);
+	}
+	queue->size -= k;
+	int wakes = k < queue->waitingProducers ? k : queue->waitingProducers;
+	for (int i = 0; i < wakes; i++) {
+		pthread_cond_signal(&queue->notFull);
+	}
+	pthread_mutex_unlock(&queue->lock);
+	return k;
+}
+
+/**
+	Adds value to the back of the queue, waiting while it is full.
+	param: 	queue 	struct BoundedQueue ptr
+	param: 	value 	TYPE
+	pre: 	queue is not null
+	ret: 	BOUNDED_QUEUE_OK, or BOUNDED_QUEUE_CLOSED if the queue is
+			(or gets) closed first
+ */
+int boundedQueueAddBack(struct BoundedQueue* queue, TYPE value)
+{
+	return addBack(queue, value, NULL);
+}
+
+/**
+	Adds value to the back of the queue, waiting at most timeoutMs
+	milliseconds for room.
+	param: 	queue 		struct BoundedQueue ptr
+	param: 	value 		TYPE
+	param: 	timeoutMs 	long
+	pre: 	queue is not null, timeoutMs >= 0
+	ret: 	BOUNDED_QUEUE_OK, BOUNDED_QUEUE_CLOSED or BOUNDED_QUEUE_TIMEOUT
+ */
+int boundedQueueTimedAddBack(struct BoundedQueue* queue, TYPE value, long timeoutMs)
+{
+	struct timespec deadline;
+	deadlineAfter(&deadline, timeoutMs);
+	return addBack(queue, value, &deadline);
+}
+
+/**
+	Removes the front value, waiting while the queue is empty.
+	param: 	queue 	struct BoundedQueue ptr
+	param: 	value 	TYPE ptr, receives the value
+	pre: 	queue and value are not null
+	ret: 	BOUNDED_QUEUE_OK, or BOUNDED_QUEUE_CLOSED once the queue is
+			closed and empty
+ */
+int boundedQueueRemoveFront(struct BoundedQueue* queue, TYPE* value)
+{
+	return removeFront(queue, value, 1, NULL) == 1 ? BOUNDED_QUEUE_OK : BOUNDED_QUEUE_CLOSED;
+}
+
+/**
+	Removes the front value, waiting at most timeoutMs milliseconds
+	for one.
+	param: 	queue 		struct BoundedQueue ptr
+	param: 	value 		TYPE ptr, receives the value
+	param: 	timeoutMs 	long
+	pre: 	queue and value are not null, timeoutMs >= 0
+	ret: 	BOUNDED_QUEUE_OK, BOUNDED_QUEUE_CLOSED or BOUNDED_QUEUE_TIMEOUT
+ */
+int boundedQueueTimedRemoveFront(struct BoundedQueue* queue, TYPE* value, long timeoutMs)
+{
+	struct timespec deadline;
+	deadlineAfter(&deadline, timeoutMs);
+	int k = removeFront(queue, value, 1, &deadline);
+	if (k < 0) return k;
+	return k == 1 ? BOUNDED_QUEUE_OK : BOUNDED_QUEUE_CLOSED;
+}
+
+/**
+	Removes up to n values from the front, in order, waiting while
+	the queue is empty; takes whatever is queued (up to n) under one
+	lock acquisition rather than waiting for n.
+	param: 	queue 	struct BoundedQueue ptr
+	param: 	out 	TYPE ptr, room for n values
+	param: 	n 		int
+	pre: 	queue and out are not null, n > 0
+	ret: 	number of values removed; 0 once the queue is closed and
+			empty
+ */
+int boundedQueueRemoveFrontN(struct BoundedQueue* queue, TYPE* out, int n)
+{
+	return removeFront(queue, out, n, NULL);
+}
+
+/**
+	Removes up to n values from the front, in order, waiting at most
+	timeoutMs milliseconds for the queue to hold any.
+	param: 	queue 		struct BoundedQueue ptr
+	param: 	out 		TYPE ptr, room for n values
+	param: 	n 			int
+	param: 	timeoutMs 	long
+	pre: 	queue and out are not null, n > 0, timeoutMs >= 0
+	ret: 	number of values removed (0 once the queue is closed and
+			empty), or BOUNDED_QUEUE_TIMEOUT
+ */
+int boundedQueueTimedRemoveFrontN(struct BoundedQueue* queue, TYPE* out, int n, long timeoutMs)
+{
+	struct timespec deadline;
+	deadlineAfter(&deadline, timeoutMs);
+	return removeFront(queue, out, n, &deadline);
+}
+
+/**
+	Closes the queue and wakes every waiting thread. Adds fail from
+	now on; removes return the values left, then report it closed.
+	param: 	queue 	struct BoundedQueue ptr
+	pre: 	queue is not null
+	post: 	queue is closed
+ */
+void boundedQueueClose(struct BoundedQueue* queue)
+{
+	assert(queue != NULL);
+	pthread_mutex_lock(&queue->lock);
+	queue->closed = 1;
+	pthread_cond_broadcast(&queue->notFull);
+	pthread_cond_broadcast(&queue->notEmpty);
+	pthread_mutex_unlock(&queue->lock);
+}
+
+/**
+	Returns the number of values in the queue; other threads may
+	change it as soon as this returns.
+	param: 	queue 	struct BoundedQueue ptr
+	pre: 	queue is not null
+	ret: 	number of values queued
+ */
+int boundedQueueSize(struct BoundedQueue* queue)
+{
+	assert(queue != NULL);
+	pthread_mutex_lock(&queue->lock);
+	int size = queue->size;
+	pthread_mutex_unlock(&queue->lock);
+	return size;
+}
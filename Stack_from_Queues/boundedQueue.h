@@ -0,0 +1,30 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include "stack_from_queue.h"
+
+struct BoundedQueue;
+
+// Results of the add/remove calls
+#define BOUNDED_QUEUE_OK 0
+#define BOUNDED_QUEUE_CLOSED (-1)	// closed (and, for removes, drained)
+#define BOUNDED_QUEUE_TIMEOUT (-2)	// timed call gave up
+
+// Thread-safe queue of at most capacity values. Adds block while it
+// is full and removes block while it is empty. After Close, adds fail
+// and removes drain what is left. Every function except Create and
+// Destroy may be called from any number of threads. Timeouts are in
+// milliseconds; 0 only tries once.
+
+struct BoundedQueue* boundedQueueCreate(int capacity);
+void boundedQueueDestroy(struct BoundedQueue* queue);
+int boundedQueueAddBack(struct BoundedQueue* queue, TYPE value);
+int boundedQueueTimedAddBack(struct BoundedQueue* queue, TYPE value, long timeoutMs);
+int boundedQueueRemoveFront(struct BoundedQueue* queue, TYPE* value);
+int boundedQueueTimedRemoveFront(struct BoundedQueue* queue, TYPE* value, long timeoutMs);
+int boundedQueueRemoveFrontN(struct BoundedQueue* queue, TYPE* out, int n);
+int boundedQueueTimedRemoveFrontN(struct BoundedQueue* queue, TYPE* out, int n, long timeoutMs);
+void boundedQueueClose(struct BoundedQueue* queue);
+int boundedQueueSize(struct BoundedQueue* queue);
+
+#endif
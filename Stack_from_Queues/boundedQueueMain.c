@@ -0,0 +1,144 @@
+/***********************************************************
+* Filename: boundedQueueMain.c
+*
+* Overview:
+*   Multithreaded test for the bounded queue in boundedQueue.c.
+*	It first checks the single-thread behavior: timeouts on a full
+*	or an empty queue, batch removes, and the close/drain rules.
+*	Then several producers and consumers share a small queue.
+*	Consumers take values in batches until the queue is closed and
+*	drained. Every value must be delivered exactly once, the values
+*	from any one producer must reach any one consumer in the order
+*	they were added, and the queue must never hold more than its
+*	capacity.
+*
+* Usage:
+* 	1) make bounded_queue
+*	2) ./bounded_queue
+************************************************************/
+#include "boundedQueue.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CAPACITY 64
+#define BATCH 16
+#define PRODUCERS 4
+#define CONSUMERS 4
+#define VALUES_PER_PRODUCER 200000
+
+struct BoundedQueue* bq;
+char* delivered;			//times each value was removed
+int inOrder = 1;
+int withinCapacity = 1;
+
+void assertTrue(int pred, char* msg)
+{
+	printf("%s: ", msg);
+	if(pred)
+		printf("\tPASSED\n");
+	else
+		printf("\tFAILED\n");
+}
+
+// Values are producer * VALUES_PER_PRODUCER + sequence number.
+void* producer(void* arg)
+{
+	int p = (int)(size_t)arg;
+	for (int i = 0; i < VALUES_PER_PRODUCER; i++) {
+		int result = boundedQueueAddBack(bq, p * VALUES_PER_PRODUCER + i);
+		assert(result == BOUNDED_QUEUE_OK);
+		(void)result;
+	}
+	return NULL;
+}
+
+void* consumer(void* arg)
+{
+	int* removed = (int*)arg;
+	int last[PRODUCERS];
+	for (int p = 0; p < PRODUCERS; p++) last[p] = -1;
+	TYPE values[BATCH];
+	int k;
+	while ((k = boundedQueueRemoveFrontN(bq, values, BATCH)) > 0) {
+		if (boundedQueueSize(bq) > CAPACITY) withinCapacity = 0;
+		for (int i = 0; i < k; i++) {
+			int p = values[i] / VALUES_PER_PRODUCER;
+			int seq = values[i] % VALUES_PER_PRODUCER;
+			if (seq <= last[p]) inOrder = 0;
+			last[p] = seq;
+			__atomic_fetch_add(&delivered[values[i]], 1, __ATOMIC_RELAXED);
+		}
+		*removed += k;
+	}
+	return NULL;
+}
+
+int main()
+{
+	printf("\n-------------------------------------------------\n");
+	printf("---------- Testing the bounded queue ------------\n");
+	printf("-------------------------------------------------\n");
+
+	bq = boundedQueueCreate(2);
+	TYPE value;
+	TYPE values[4];
+	assertTrue(boundedQueueTimedRemoveFront(bq, &value, 10) == BOUNDED_QUEUE_TIMEOUT,
+		"empty timed remove times out");
+	assertTrue(boundedQueueAddBack(bq, 7) == BOUNDED_QUEUE_OK, "adding 7");
+	assertTrue(boundedQueueAddBack(bq, 8) == BOUNDED_QUEUE_OK, "adding 8");
+	assertTrue(boundedQueueTimedAddBack(bq, 9, 10) == BOUNDED_QUEUE_TIMEOUT,
+		"full timed add times out");
+	assertTrue(boundedQueueSize(bq) == 2, "size == 2");
+	assertTrue(boundedQueueRemoveFront(bq, &value) == BOUNDED_QUEUE_OK && value == 7,
+		"removing; val == 7");
+	assertTrue(boundedQueueTimedAddBack(bq, 9, 0) == BOUNDED_QUEUE_OK, "adding 9");
+	assertTrue(boundedQueueRemoveFrontN(bq, values, 4) == 2 && values[0] == 8 && values[1] == 9,
+		"batch remove takes 8, 9");
+	boundedQueueAddBack(bq, 10);
+	boundedQueueClose(bq);
+	assertTrue(boundedQueueAddBack(bq, 11) == BOUNDED_QUEUE_CLOSED, "add after close fails");
+	assertTrue(boundedQueueTimedRemoveFront(bq, &value, 10) == BOUNDED_QUEUE_OK && value == 10,
+		"remove after close drains 10");
+	assertTrue(boundedQueueRemoveFront(bq, &value) == BOUNDED_QUEUE_CLOSED,
+		"drained remove reports closed");
+	assertTrue(boundedQueueRemoveFrontN(bq, values, 4) == 0, "drained batch remove returns 0");
+	boundedQueueDestroy(bq);
+
+	printf("\n%d producers, %d consumers, capacity %d, %d values each...\n",
+		PRODUCERS, CONSUMERS, CAPACITY, VALUES_PER_PRODUCER);
+	bq = boundedQueueCreate(CAPACITY);
+	delivered = calloc(PRODUCERS * VALUES_PER_PRODUCER, 1);
+	assert(delivered != NULL);
+	pthread_t producers[PRODUCERS], consumers[CONSUMERS];
+	int removed[CONSUMERS] = {0};
+	for (int i = 0; i < CONSUMERS; i++) {
+		pthread_create(&consumers[i], NULL, consumer, &removed[i]);
+	}
+	for (int i = 0; i < PRODUCERS; i++) {
+		pthread_create(&producers[i], NULL, producer, (void*)(size_t)i);
+	}
+	for (int i = 0; i < PRODUCERS; i++) {
+		pthread_join(producers[i], NULL);
+	}
+	boundedQueueClose(bq);
+	int total = 0;
+	for (int i = 0; i < CONSUMERS; i++) {
+		pthread_join(consumers[i], NULL);
+		total += removed[i];
+	}
+	int once = 1;
+	for (int i = 0; i < PRODUCERS * VALUES_PER_PRODUCER; i++) {
+		if (delivered[i] != 1) once = 0;
+	}
+	assertTrue(total == PRODUCERS * VALUES_PER_PRODUCER, "all values removed");
+	assertTrue(once, "each value removed once");
+	assertTrue(inOrder, "per producer order kept");
+	assertTrue(withinCapacity, "size never above capacity");
+	assertTrue(boundedQueueSize(bq) == 0, "size == 0");
+	boundedQueueDestroy(bq);
+	free(delivered);
+
+	return 0;
+}
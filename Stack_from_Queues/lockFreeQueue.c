@@ -0,0 +1,490 @@
+/***********************************************************
+* Filename: lockFreeQueue.c
+*
+* Overview:
+*   This program has two lock-free versions of the singly linked
+*	queue from stack_from_queue.c, for handing values between
+*	threads without an external mutex. Both keep the same shape
+*	(a sentinel link, head and tail pointers, enqueue at the back
+*	and dequeue at the front) but link through C11 atomics.
+*
+*	SpscQueue (one producer thread, one consumer thread):
+*		The consumer only moves head and the producer only moves
+*		tail, so no CAS is needed. Links the consumer has moved
+*		past are not freed; the producer reuses them for new
+*		values (it owns every link from first up to head), so a
+*		steady stream of values does not malloc at all.
+*
+*	MpmcQueue (any number of producers and consumers):
+*		Michael-Scott queue. Enqueue CASes the last link's next
+*		and then swings tail; dequeue CASes head forward, and any
+*		thread that sees tail lagging behind helps move it.
+*		A dequeued sentinel may still be read by other threads,
+*		so it is retired instead of freed and reclaimed later with
+*		hazard pointers: before dereferencing head, tail or next a
+*		thread publishes the pointer in its hazard record, and a
+*		retired link is only freed once no record points at it.
+*		Hazard records are shared by every MpmcQueue, claimed by
+*		a thread on its first operation and handed back when the
+*		thread exits, so at most LFQ_MAX_THREADS threads may use
+*		MpmcQueues at the same time.
+*
+* Usage:
+* 	gcc -g -Wall -std=c11 -pthread -c lockFreeQueue.c
+************************************************************/
+#include "lockFreeQueue.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef LFQ_MAX_THREADS
+#define LFQ_MAX_THREADS 64
+#endif
+
+#define CACHE_LINE 64
+#define HAZARDS_PER_THREAD 2
+#define RETIRE_THRESHOLD (2 * HAZARDS_PER_THREAD * LFQ_MAX_THREADS)
+
+// Single link with an atomic next pointer
+struct LfLink {
+	TYPE value;
+	_Atomic(struct LfLink*) next;
+};
+
+// Producer and consumer fields are kept on separate cache lines.
+struct SpscQueue {
+	_Alignas(CACHE_LINE) _Atomic(struct LfLink*) head;	//consumer
+	_Alignas(CACHE_LINE) struct LfLink* tail;				//producer
+	struct LfLink* first;		//oldest link the producer may reuse
+	struct LfLink* headCopy;	//producer's last look at head
+};
+
+struct MpmcQueue {
+	_Alignas(CACHE_LINE) _Atomic(struct LfLink*) head;
+	_Alignas(CACHE_LINE) _Atomic(struct LfLink*) tail;
+};
+
+// Per thread hazard pointers and links waiting to be freed
+struct HazardRecord {
+	_Alignas(CACHE_LINE) _Atomic(struct LfLink*) hazard[HAZARDS_PER_THREAD];
+	atomic_int active;
+	int retiredCount;
+	struct LfLink* retired[RETIRE_THRESHOLD];
+};
+
+static struct HazardRecord hazardRecords[LFQ_MAX_THREADS];
+static _Thread_local struct HazardRecord* myRecord;
+static pthread_key_t recordKey;
+static pthread_once_t recordKeyOnce = PTHREAD_ONCE_INIT;
+
+////////////////SPSC/////////////////SPSC///////////SPSC////////////////
+
+/**
+	Gets a link for the producer: one the consumer is done with if
+	there is one, otherwise a new one.
+	param: 	queue 	struct SpscQueue ptr
+	pre: 	queue is not null, called by the producer
+	ret: 	link (never null); its fields are uninitialized
+ */
+static struct LfLink* spscAllocLink(struct SpscQueue* queue)
+{
+	if (queue->first == queue->headCopy) {
+		queue->headCopy = atomic_load_explicit(&queue->head, memory_order_acquire);
+	}
+	if (queue->first != queue->headCopy) {
+		struct LfLink* lnk = queue->first;
+		queue->first = atomic_load_explicit(&lnk->next, memory_order_relaxed);
+		return lnk;
+	}
+	struct LfLink* lnk = (struct LfLink *)malloc(sizeof(struct LfLink));
+	assert(lnk != NULL);
+	return lnk;
+}
+
+/**
+	Allocates and initializes an SPSC queue with a sentinel link.
+	pre: 	none
+	post: 	head, tail and the reuse pointers all point to the sentinel
+	return: queue
+ */
+struct SpscQueue* spscQueueCreate()
+{
+	struct SpscQueue* queue = aligned_alloc(CACHE_LINE, sizeof(struct SpscQueue));
+	assert(queue != NULL);
+	struct LfLink* sentinel = (struct LfLink *)malloc(sizeof(struct LfLink));
+	assert(sentinel != NULL);
+	atomic_init(&sentinel->next, NULL);
+	atomic_init(&queue->head, sentinel);
+	queue->tail = queue->first = queue->headCopy = sentinel;
+	return queue;
+}
+
+/**
+	Frees every link (reusable ones, the sentinel and queued ones)
+	and the queue itself.
+	param:	queue 	struct SpscQueue ptr
+	pre: 	queue is not null, no other thread is using it
+	post: 	memory allocated to each link and the queue is freed
+ */
+void spscQueueDestroy(struct SpscQueue* queue)
+{
+	assert(queue != NULL);
+	struct LfLink* lnk = queue->first;
+	while (lnk != NULL) {
+		struct LfLink* next = atomic_load_explicit(&lnk->next, memory_order_relaxed);
+		free(lnk);
+		lnk = next;
+	}
+	free(queue);
+}
+
+/**
+	Adds a value to the back of the queue. Producer only.
+	param: 	queue 	struct SpscQueue ptr
+	param: 	value 	TYPE
+	pre: 	queue is not null
+	post: 	link with value is published after the current last link
+ */
+void spscQueueAddBack(struct SpscQueue* queue, TYPE value)
+{
+	assert(queue != NULL);
+	struct LfLink* lnk = spscAllocLink(queue);
+	lnk->value = value;
+	atomic_store_explicit(&lnk->next, NULL, memory_order_relaxed);
+	atomic_store_explicit(&queue->tail->next, lnk, memory_order_release);
+	queue->tail = lnk;
+}
+
+/**
+	Returns the value at the front of the queue. Consumer only.
+	param: 	queue 	struct SpscQueue ptr
+	pre:	queue is not null and not empty
+	ret:	first value
+ */
+TYPE spscQueueFront(struct SpscQueue* queue)
+{
+	assert(queue != NULL);
+	struct LfLink* head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+	struct LfLink* next = atomic_load_explicit(&head->next, memory_order_acquire);
+	assert(next != NULL);
+	return next->value;
+}
+
+/**
+	Removes the front value if there is one. Consumer only. The old
+	sentinel is left for the producer to reuse; the first link
+	becomes the new sentinel.
+	param: 	queue 	struct SpscQueue ptr
+	param: 	value 	TYPE ptr, receives the removed value
+	pre:	queue and value are not null
+	ret:	1 if a value was removed, 0 if the queue was empty
+ */
+int spscQueueTryRemoveFront(struct SpscQueue* queue, TYPE* value)
+{
+	assert(queue != NULL && value != NULL);
+	struct LfLink* head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+	struct LfLink* next = atomic_load_explicit(&head->next, memory_order_acquire);
+	if (next == NULL) return 0;
+	*value = next->value;
+	atomic_store_explicit(&queue->head, next, memory_order_release);
+	return 1;
+}
+
+/**
+	Removes the front value and returns it. Consumer only.
+	param: 	queue 	struct SpscQueue ptr
+	pre:	queue is not null and not empty
+	ret:	removed value
+ */
+TYPE spscQueueRemoveFront(struct SpscQueue* queue)
+{
+	TYPE val;
+	int removed = spscQueueTryRemoveFront(queue, &val);
+	assert(removed);
+	(void)removed;
+	return val;
+}
+
+/**
+	Returns 1 if the queue is empty and 0 otherwise. Producer or
+	consumer only; from the producer the answer may already be stale.
+	param:	queue	struct SpscQueue ptr
+	pre:	queue is not null
+	ret:	1 if empty, otherwise 0
+ */
+int spscQueueIsEmpty(struct SpscQueue* queue)
+{
+	assert(queue != NULL);
+	struct LfLink* head = atomic_load_explicit(&queue->head, memory_order_acquire);
+	return atomic_load_explicit(&head->next, memory_order_acquire) == NULL;
+}
+
+////////////////HAZARD POINTERS/////////////////////////////////////////
+
+static int comparePointers(const void* a, const void* b)
+{
+	const struct LfLink* x = *(struct LfLink* const*)a;
+	const struct LfLink* y = *(struct LfLink* const*)b;
+	return (x > y) - (x < y);
+}
+
+/**
+	Frees every link in the record's retired list that is not
+	currently published as a hazard by any thread.
+	param: 	record 	struct HazardRecord ptr
+	pre: 	record is owned by the calling thread
+	post: 	record's retired list only holds hazardous links
+ */
+static void scanRetired(struct HazardRecord* record)
+{
+	struct LfLink* hazards[LFQ_MAX_THREADS * HAZARDS_PER_THREAD];
+	int count = 0;
+	for (int i = 0; i < LFQ_MAX_THREADS; i++) {
+		for (int j = 0; j < HAZARDS_PER_THREAD; j++) {
+			struct LfLink* hp = atomic_load(&hazardRecords[i].hazard[j]);
+			if (hp != NULL) hazards[count++] = hp;
+		}
+	}
+	qsort(hazards, count, sizeof(struct LfLink*), comparePointers);
+	int kept = 0;
+	for (int i = 0; i < record->retiredCount; i++) {
+		struct LfLink* lnk = record->retired[i];
+		if (bsearch(&lnk, hazards, count, sizeof(struct LfLink*), comparePointers) != NULL) {
+			record->retired[kept++] = lnk;
+		}
+		else {
+			free(lnk);
+		}
+	}
+	record->retiredCount = kept;
+}
+
+/**
+	Thread exit handler: clears the thread's hazards, frees what it
+	can and hands the record (with any retired links left) back.
+ */
+static void releaseRecord(void* arg)
+{
+	struct HazardRecord* record = (struct HazardRecord*)arg;
+	for (int j = 0; j < HAZARDS_PER_THREAD; j++) {
+		atomic_store(&record->hazard[j], NULL);
+	}
+	scanRetired(record);
+	atomic_store(&record->active, 0);
+}
+
+static void createRecordKey(void)
+{
+	int rc = pthread_key_create(&recordKey, releaseRecord);
+	assert(rc == 0);
+	(void)rc;
+}
+
+/**
+	Returns the calling thread's hazard record, claiming a free one
+	on the thread's first call. Aborts if all LFQ_MAX_THREADS
+	records are taken, in every build.
+	ret: 	record owned by the calling thread
+ */
+static struct HazardRecord* getRecord(void)
+{
+	if (myRecord != NULL) return myRecord;
+	pthread_once(&recordKeyOnce, createRecordKey);
+	for (int i = 0; i < LFQ_MAX_THREADS; i++) {
+		int expected = 0;
+		if (atomic_compare_exchange_strong(&hazardRecords[i].active, &expected, 1)) {
+			myRecord = &hazardRecords[i];
+			pthread_setspecific(recordKey, myRecord);
+			return myRecord;
+		}
+	}
+	//Not an assert: without a record protect would dereference NULL.
+	fprintf(stderr, "lockFreeQueue: more than %d threads using MpmcQueue\n", LFQ_MAX_THREADS);
+	abort();
+}
+
+/**
+	Publishes the pointer currently in src as hazard slot and returns
+	it, retrying until src still holds the same pointer afterwards
+	(so it cannot have been retired before it was published).
+ */
+static struct LfLink* protect(struct HazardRecord* record, int slot,
+	_Atomic(struct LfLink*)* src)
+{
+	struct LfLink* lnk = atomic_load(src);
+	for (;;) {
+		atomic_store(&record->hazard[slot], lnk);
+		struct LfLink* again = atomic_load(src);
+		if (again == lnk) return lnk;
+		lnk = again;
+	}
+}
+
+/**
+	Queues a link that has been unlinked from an MpmcQueue to be
+	freed once no thread holds a hazard pointer to it.
+ */
+static void retire(struct HazardRecord* record, struct LfLink* lnk)
+{
+	record->retired[record->retiredCount++] = lnk;
+	if (record->retiredCount == RETIRE_THRESHOLD) {
+		scanRetired(record);
+	}
+}
+
+////////////////MPMC/////////////////MPMC///////////MPMC////////////////
+
+/**
+	Allocates and initializes an MPMC queue with a sentinel link.
+	pre: 	none
+	post: 	head and tail point to the sentinel
+	return: queue
+ */
+struct MpmcQueue* mpmcQueueCreate()
+{
+	struct MpmcQueue* queue = aligned_alloc(CACHE_LINE, sizeof(struct MpmcQueue));
+	assert(queue != NULL);
+	struct LfLink* sentinel = (struct LfLink *)malloc(sizeof(struct LfLink));
+	assert(sentinel != NULL);
+	atomic_init(&sentinel->next, NULL);
+	atomic_init(&queue->head, sentinel);
+	atomic_init(&queue->tail, sentinel);
+	return queue;
+}
+
+/**
+	Frees the links still in the queue, the sentinel and the queue,
+	and scans the calling thread's retired list, since a thread that
+	never exits (such as main) would otherwise keep up to
+	RETIRE_THRESHOLD - 1 retired links forever. Links other threads
+	retired are freed by their own scans, at the latest when they
+	exit.
+	param:	queue 	struct MpmcQueue ptr
+	pre: 	queue is not null, no other thread is using it
+	post: 	memory allocated to each link and the queue is freed;
+			the caller's retired list only holds links other
+			threads still protect
+ */
+void mpmcQueueDestroy(struct MpmcQueue* queue)
+{
+	assert(queue != NULL);
+	if (myRecord != NULL) {
+		scanRetired(myRecord);
+	}
+	struct LfLink* lnk = atomic_load(&queue->head);
+	while (lnk != NULL) {
+		struct LfLink* next = atomic_load(&lnk->next);
+		free(lnk);
+		lnk = next;
+	}
+	free(queue);
+}
+
+/**
+	Adds a value to the back of the queue.
+	param: 	queue 	struct MpmcQueue ptr
+	param: 	value 	TYPE
+	pre: 	queue is not null
+	post: 	link with value is linked after the last link
+ */
+void mpmcQueueAddBack(struct MpmcQueue* queue, TYPE value)
+{
+	assert(queue != NULL);
+	struct HazardRecord* record = getRecord();
+	struct LfLink* lnk = (struct LfLink *)malloc(sizeof(struct LfLink));
+	assert(lnk != NULL);
+	lnk->value = value;
+	atomic_init(&lnk->next, NULL);
+	struct LfLink* tail;
+	for (;;) {
+		tail = protect(record, 0, &queue->tail);
+		struct LfLink* next = atomic_load(&tail->next);
+		if (tail != atomic_load(&queue->tail)) continue;
+		if (next != NULL) {
+			//Tail is lagging; help move it before retrying.
+			atomic_compare_exchange_strong(&queue->tail, &tail, next);
+			continue;
+		}
+		struct LfLink* expected = NULL;
+		if (atomic_compare_exchange_strong(&tail->next, &expected, lnk)) break;
+	}
+	atomic_compare_exchange_strong(&queue->tail, &tail, lnk);
+	atomic_store(&record->hazard[0], NULL);
+}
+
+/**
+	Shared body of TryFront and TryRemoveFront.
+	param: 	queue 	struct MpmcQueue ptr
+	param: 	value 	TYPE ptr, receives the front value
+	param: 	remove 	int, 1 to also remove the front value
+	ret:	1 if there was a front value, 0 if the queue was empty
+ */
+static int mpmcFront(struct MpmcQueue* queue, TYPE* value, int remove)
+{
+	assert(queue != NULL && value != NULL);
+	struct HazardRecord* record = getRecord();
+	struct LfLink* head;
+	for (;;) {
+		head = protect(record, 0, &queue->head);
+		struct LfLink* tail = atomic_load(&queue->tail);
+		struct LfLink* next = protect(record, 1, &head->next);
+		if (head != atomic_load(&queue->head)) continue;
+		if (next == NULL) {
+			atomic_store(&record->hazard[0], NULL);
+			atomic_store(&record->hazard[1], NULL);
+			return 0;
+		}
+		if (head == tail) {
+			atomic_compare_exchange_strong(&queue->tail, &tail, next);
+			continue;
+		}
+		*value = next->value;
+		if (!remove || atomic_compare_exchange_strong(&queue->head, &head, next)) break;
+	}
+	atomic_store(&record->hazard[0], NULL);
+	atomic_store(&record->hazard[1], NULL);
+	if (remove) retire(record, head);
+	return 1;
+}
+
+/**
+	Reads the value at the front of the queue without removing it.
+	param: 	queue 	struct MpmcQueue ptr
+	param: 	value 	TYPE ptr, receives the front value
+	pre:	queue and value are not null
+	ret:	1 if there was a front value, 0 if the queue was empty
+ */
+int mpmcQueueTryFront(struct MpmcQueue* queue, TYPE* value)
+{
+	return mpmcFront(queue, value, 0);
+}
+
+/**
+	Removes the front value if there is one.
+	param: 	queue 	struct MpmcQueue ptr
+	param: 	value 	TYPE ptr, receives the removed value
+	pre:	queue and value are not null
+	ret:	1 if a value was removed, 0 if the queue was empty
+ */
+int mpmcQueueTryRemoveFront(struct MpmcQueue* queue, TYPE* value)
+{
+	return mpmcFront(queue, value, 1);
+}
+
+/**
+	Returns 1 if the queue is empty and 0 otherwise (a snapshot).
+	param:	queue	struct MpmcQueue ptr
+	pre:	queue is not null
+	ret:	1 if empty, otherwise 0
+ */
+int mpmcQueueIsEmpty(struct MpmcQueue* queue)
+{
+	assert(queue != NULL);
+	struct HazardRecord* record = getRecord();
+	struct LfLink* head = protect(record, 0, &queue->head);
+	int empty = atomic_load(&head->next) == NULL;
+	atomic_store(&record->hazard[0], NULL);
+	return empty;
+}
@@ -0,0 +1,32 @@
+#ifndef LOCK_FREE_QUEUE_H
+#define LOCK_FREE_QUEUE_H
+
+#ifndef TYPE
+#define TYPE int
+#endif
+
+struct SpscQueue;
+struct MpmcQueue;
+
+// Single producer / single consumer queue. AddBack may only be called
+// from one thread and Front/RemoveFront/TryRemoveFront from one other.
+
+struct SpscQueue* spscQueueCreate();
+void spscQueueDestroy(struct SpscQueue* queue);
+void spscQueueAddBack(struct SpscQueue* queue, TYPE value);
+TYPE spscQueueFront(struct SpscQueue* queue);
+TYPE spscQueueRemoveFront(struct SpscQueue* queue);
+int spscQueueTryRemoveFront(struct SpscQueue* queue, TYPE* value);
+int spscQueueIsEmpty(struct SpscQueue* queue);
+
+// Multi producer / multi consumer queue; every function except
+// Create/Destroy may be called from any number of threads.
+
+struct MpmcQueue* mpmcQueueCreate();
+void mpmcQueueDestroy(struct MpmcQueue* queue);
+void mpmcQueueAddBack(struct MpmcQueue* queue, TYPE value);
+int mpmcQueueTryFront(struct MpmcQueue* queue, TYPE* value);
+int mpmcQueueTryRemoveFront(struct MpmcQueue* queue, TYPE* value);
+int mpmcQueueIsEmpty(struct MpmcQueue* queue);
+
+#endif
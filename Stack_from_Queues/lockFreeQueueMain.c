@@ -0,0 +1,170 @@
+/***********************************************************
+* Filename: lockFreeQueueMain.c
+*
+* Overview:
+*   Multithreaded stress test for the queues in lockFreeQueue.c.
+*	The SPSC queue gets one producer and one consumer thread and
+*	must deliver every value in order. The MPMC queue gets several
+*	producers and consumers at once; every value must be delivered
+*	exactly once and the values from any one producer must reach
+*	any one consumer in the order they were added.
+*
+* Usage:
+* 	1) make lock_free_queue
+*	2) ./lock_free_queue
+************************************************************/
+#include "lockFreeQueue.h"
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SPSC_VALUES 1000000
+#define PRODUCERS 4
+#define CONSUMERS 4
+#define VALUES_PER_PRODUCER 200000
+
+struct SpscQueue* spsc;
+struct MpmcQueue* mpmc;
+int spscInOrder = 1;
+char* delivered;			//times each MPMC value was removed
+int mpmcInOrder = 1;
+
+void assertTrue(int pred, char* msg)
+{
+	printf("%s: ", msg);
+	if(pred)
+		printf("\tPASSED\n");
+	else
+		printf("\tFAILED\n");
+}
+
+void* spscProducer(void* arg)
+{
+	(void)arg;
+	for (int i = 0; i < SPSC_VALUES; i++) {
+		spscQueueAddBack(spsc, i);
+	}
+	return NULL;
+}
+
+void* spscConsumer(void* arg)
+{
+	(void)arg;
+	int expected = 0;
+	while (expected < SPSC_VALUES) {
+		TYPE value;
+		if (!spscQueueTryRemoveFront(spsc, &value)) {
+			sched_yield();
+			continue;
+		}
+		if (value != expected) spscInOrder = 0;
+		expected++;
+	}
+	return NULL;
+}
+
+// Values are producer * VALUES_PER_PRODUCER + sequence number.
+void* mpmcProducer(void* arg)
+{
+	int producer = (int)(size_t)arg;
+	for (int i = 0; i < VALUES_PER_PRODUCER; i++) {
+		mpmcQueueAddBack(mpmc, producer * VALUES_PER_PRODUCER + i);
+	}
+	return NULL;
+}
+
+void* mpmcConsumer(void* arg)
+{
+	int* removed = (int*)arg;
+	int last[PRODUCERS];
+	for (int p = 0; p < PRODUCERS; p++) last[p] = -1;
+	for (;;) {
+		TYPE value;
+		//Only stop on an empty queue seen after all producers finished.
+		int done = __atomic_load_n(removed + 1, __ATOMIC_ACQUIRE);
+		if (!mpmcQueueTryRemoveFront(mpmc, &value)) {
+			if (done) break;
+			sched_yield();
+			continue;
+		}
+		int producer = value / VALUES_PER_PRODUCER;
+		int seq = value % VALUES_PER_PRODUCER;
+		if (seq <= last[producer]) mpmcInOrder = 0;
+		last[producer] = seq;
+		__atomic_fetch_add(&delivered[value], 1, __ATOMIC_RELAXED);
+		removed[0]++;
+	}
+	return NULL;
+}
+
+int main()
+{
+	printf("\n-------------------------------------------------\n");
+	printf("-------- Stress testing lock-free queues --------\n");
+	printf("-------------------------------------------------\n");
+
+	spsc = spscQueueCreate();
+	assertTrue(spscQueueIsEmpty(spsc) == 1, "spsc isEmpty == 1");
+	spscQueueAddBack(spsc, 7);
+	spscQueueAddBack(spsc, 8);
+	assertTrue(spscQueueFront(spsc) == 7, "spsc front == 7");
+	assertTrue(spscQueueRemoveFront(spsc) == 7, "spsc removing; val == 7");
+	assertTrue(spscQueueRemoveFront(spsc) == 8, "spsc removing; val == 8");
+	assertTrue(spscQueueIsEmpty(spsc) == 1, "spsc isEmpty == 1");
+
+	printf("\n1 producer, 1 consumer, %d values...\n", SPSC_VALUES);
+	pthread_t producer, consumer;
+	pthread_create(&producer, NULL, spscProducer, NULL);
+	pthread_create(&consumer, NULL, spscConsumer, NULL);
+	pthread_join(producer, NULL);
+	pthread_join(consumer, NULL);
+	assertTrue(spscInOrder, "spsc values in order");
+	assertTrue(spscQueueIsEmpty(spsc) == 1, "spsc isEmpty == 1");
+	spscQueueDestroy(spsc);
+
+	mpmc = mpmcQueueCreate();
+	TYPE value;
+	assertTrue(mpmcQueueTryRemoveFront(mpmc, &value) == 0, "\nmpmc empty remove fails");
+	mpmcQueueAddBack(mpmc, 7);
+	assertTrue(mpmcQueueTryFront(mpmc, &value) && value == 7, "mpmc front == 7");
+	assertTrue(mpmcQueueTryRemoveFront(mpmc, &value) && value == 7, "mpmc removing; val == 7");
+	assertTrue(mpmcQueueIsEmpty(mpmc) == 1, "mpmc isEmpty == 1");
+
+	printf("\n%d producers, %d consumers, %d values each...\n",
+		PRODUCERS, CONSUMERS, VALUES_PER_PRODUCER);
+	delivered = calloc(PRODUCERS * VALUES_PER_PRODUCER, 1);
+	assert(delivered != NULL);
+	pthread_t producers[PRODUCERS], consumers[CONSUMERS];
+	int removed[CONSUMERS][2] = {{0}};
+	for (int i = 0; i < CONSUMERS; i++) {
+		pthread_create(&consumers[i], NULL, mpmcConsumer, removed[i]);
+	}
+	for (int i = 0; i < PRODUCERS; i++) {
+		pthread_create(&producers[i], NULL, mpmcProducer, (void*)(size_t)i);
+	}
+	for (int i = 0; i < PRODUCERS; i++) {
+		pthread_join(producers[i], NULL);
+	}
+	for (int i = 0; i < CONSUMERS; i++) {
+		__atomic_store_n(&removed[i][1], 1, __ATOMIC_RELEASE);
+	}
+	int total = 0;
+	for (int i = 0; i < CONSUMERS; i++) {
+		pthread_join(consumers[i], NULL);
+		total += removed[i][0];
+	}
+	int once = 1;
+	for (int i = 0; i < PRODUCERS * VALUES_PER_PRODUCER; i++) {
+		if (delivered[i] != 1) once = 0;
+	}
+	assertTrue(total == PRODUCERS * VALUES_PER_PRODUCER, "mpmc all values removed");
+	assertTrue(once, "mpmc each value removed once");
+	assertTrue(mpmcInOrder, "mpmc per producer order kept");
+	assertTrue(mpmcQueueIsEmpty(mpmc) == 1, "mpmc isEmpty == 1");
+	mpmcQueueDestroy(mpmc);
+	free(delivered);
+
+	return 0;
+}
@@ -0,0 +1,55 @@
+/***********************************************************
+* Filename: stackArray.c
+*
+* Overview:
+*   This program is a growable array implementation of the stack
+*	declared in stack_from_queue.h. It is a drop-in replacement for
+*	the two-queue stack in stack_from_queue.c (see makefile,
+*	STACK_ENGINE=stackArray) and allows for the same behavior:
+*		- adding a new value to the top (push, one or a batch)
+*		- removing the top value (pop)
+*		- getting the top value (top)
+*		- checking if the stack is empty
+*
+*	The values sit in one array, bottom first, so push and pop only
+*	touch its end and never malloc per value. A full array doubles,
+*	which makes push amortized O(1). listStackReserve grows the
+*	array up front, and the capacity it asks for becomes the floor
+*	the array never shrinks below. Unless built with
+*	-DSTACK_ARRAY_NO_SHRINK, a pop that leaves the array a quarter
+*	full halves it. Halving at a quarter rather than at half leaves
+*	room both ways, so alternating push/pop at a boundary does not
+*	resize every time.
+*
+*	With -DCONTAINER_STATS the link counters in StackStats count
+*	arrays rather than values, and splices stays 0.
+*
+*	The code is stackTemplate.h's, instantiated once for TYPE with
+*	external linkage, so the template and this engine are one array
+*	stack: STACK_DEFINE_STRUCT writes struct Stack and
+*	STACK_DEFINE_FUNCTIONS every listStack call.
+*	STACK_ARRAY_MIN_CAPACITY and STACK_ARRAY_NO_SHRINK set the
+*	template's STACK_MIN_CAPACITY and STACK_NO_SHRINK.
+*
+* Usage:
+* 	gcc -g -Wall -std=c99 -c stackArray.c
+************************************************************/
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stack_from_queue.h"
+
+// Capacity of a new stack
+#ifdef STACK_ARRAY_MIN_CAPACITY
+#define STACK_MIN_CAPACITY STACK_ARRAY_MIN_CAPACITY
+#endif
+
+#ifdef STACK_ARRAY_NO_SHRINK
+#define STACK_NO_SHRINK
+#endif
+
+#include "stackTemplate.h"
+
+STACK_DEFINE_STRUCT(Stack, TYPE)
+
+STACK_DEFINE_FUNCTIONS(Stack, listStack, TYPE, )
@@ -0,0 +1,215 @@
+/***********************************************************
+* Filename: stackTemplate.h
+*
+* Overview:
+*   Macro template for type-specialized stacks. Where
+*	stack_from_queue.h has one TYPE per build, STACK_DEFINE(name,
+*	type) writes out a whole stack for one element type, with every
+*	function named after name, so any number of element types live
+*	in one program:
+*
+*		STACK_DEFINE(intStack, int)
+*		STACK_DEFINE(pointStack, struct Point)
+*
+*	The stack is the growable array stackArray.c is generated from
+*	(with STACK_DEFINE_STRUCT and STACK_DEFINE_FUNCTIONS): values
+*	bottom first, doubling when full, with the capacity Reserve asks
+*	for as a floor. Unless STACK_NO_SHRINK is defined, a pop that
+*	leaves the array a quarter full halves it. Every function
+*	STACK_DEFINE writes is static inline, so each instantiation is
+*	compiled, and can be inlined, for its own type.
+*
+*	For STACK_DEFINE(name, ...) the generated interface is the one
+*	in stack_from_queue.h with listStack/Stack replaced by name
+*	(nameCreate, nameReserve, nameDestroy, nameIsEmpty, namePush,
+*	namePushN, namePop, nameTop, and with -DCONTAINER_STATS
+*	nameGetStats on a struct nameStats), plus:
+*		size_t nameSize(struct name* stack)
+*	The pre/post conditions match stack_from_queue.h.
+*
+* Usage:
+* 	#include "stackTemplate.h" and STACK_DEFINE once per element
+*	type, at file scope, in each file that uses it.
+************************************************************/
+#ifndef STACK_TEMPLATE_H
+#define STACK_TEMPLATE_H
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Capacity of a new stack
+#ifndef STACK_MIN_CAPACITY
+#define STACK_MIN_CAPACITY 16
+#endif
+
+// Operation counters (only when built with -DCONTAINER_STATS); the
+// fields match struct StackStats, counting arrays as links.
+#ifdef CONTAINER_STATS
+#define STACK_STAT(stack, field, n) ((stack)->stats.field += (n))
+#define STACK_STATS_INIT(stack, bytes) \
+	(memset(&(stack)->stats, 0, sizeof((stack)->stats)), \
+	(stack)->stats.linksAllocated = 1, (stack)->stats.bytesLive = (long)(bytes))
+#define STACK_STATS_MEMBER(Tag) struct Tag##Stats stats;
+#define STACK_STATS_TYPE(Tag) \
+	struct Tag##Stats \
+	{ \
+		long push, pushN, pop, top; \
+		long linksAllocated, linksFreed, bytesLive, splices; \
+	};
+#define STACK_STATS_GET(Tag, p, scope) \
+	scope void p##GetStats(struct Tag* stack, struct Tag##Stats* stats) \
+	{ \
+		assert(stack != NULL && stats != NULL); \
+		*stats = stack->stats; \
+	}
+#else
+#define STACK_STAT(stack, field, n) ((void)0)
+#define STACK_STATS_INIT(stack, bytes) ((void)0)
+#define STACK_STATS_MEMBER(Tag)
+#define STACK_STATS_TYPE(Tag)
+#define STACK_STATS_GET(Tag, p, scope)
+#endif
+
+#ifdef STACK_NO_SHRINK
+#define STACK_SHRINKS 0
+#else
+#define STACK_SHRINKS 1
+#endif
+
+// Writes struct Tag, the stack itself. stackArray.c uses it on its
+// own, since stack_from_queue.h declares struct StackStats.
+#define STACK_DEFINE_STRUCT(Tag, type) \
+struct Tag \
+{ \
+	type* values; \
+	size_t size; \
+	size_t capacity; \
+	size_t floor;	/* least capacity a shrink goes down to */ \
+	STACK_STATS_MEMBER(Tag) \
+};
+
+// Writes (with -DCONTAINER_STATS) struct TagStats.
+#define STACK_DEFINE_TYPES(Tag) \
+STACK_STATS_TYPE(Tag)
+
+// Writes every stack function, named p##Create and so on, on
+// struct Tag, with the linkage given by scope (static inline, or
+// nothing for stackArray.c's external definitions). Helpers are
+// always static inline.
+#define STACK_DEFINE_FUNCTIONS(Tag, p, type, scope) \
+/* Moves the values into an array of capacity values. */ \
+static inline void p##SetCapacity(struct Tag* stack, size_t capacity) \
+{ \
+	type* values = (type*)realloc(stack->values, capacity * sizeof(type)); \
+	assert(values != NULL); \
+	STACK_STAT(stack, linksAllocated, 1); \
+	STACK_STAT(stack, linksFreed, 1); \
+	STACK_STAT(stack, bytesLive, ((long)capacity - (long)stack->capacity) * (long)sizeof(type)); \
+	stack->values = values; \
+	stack->capacity = capacity; \
+} \
+ \
+scope struct Tag* p##Create(void) \
+{ \
+	struct Tag* stack = (struct Tag*)malloc(sizeof(struct Tag)); \
+	assert(stack != NULL); \
+	stack->values = (type*)malloc(STACK_MIN_CAPACITY * sizeof(type)); \
+	assert(stack->values != NULL); \
+	stack->size = 0; \
+	stack->capacity = STACK_MIN_CAPACITY; \
+	stack->floor = STACK_MIN_CAPACITY; \
+	STACK_STATS_INIT(stack, sizeof(struct Tag) + STACK_MIN_CAPACITY * sizeof(type)); \
+	return stack; \
+} \
+ \
+scope void p##Reserve(struct Tag* stack, size_t n) \
+{ \
+	assert(stack != NULL); \
+	if (n > stack->floor) { \
+		stack->floor = n; \
+	} \
+	if (n > stack->capacity) { \
+		p##SetCapacity(stack, n); \
+	} \
+} \
+ \
+scope void p##Destroy(struct Tag* stack) \
+{ \
+	assert(stack != NULL); \
+	free(stack->values); \
+	free(stack); \
+} \
+ \
+scope int p##IsEmpty(struct Tag* stack) \
+{ \
+	assert(stack != NULL); \
+	return stack->size == 0; \
+} \
+ \
+static inline size_t p##Size(struct Tag* stack) \
+{ \
+	assert(stack != NULL); \
+	return stack->size; \
+} \
+ \
+scope void p##Push(struct Tag* stack, type value) \
+{ \
+	assert(stack != NULL); \
+	STACK_STAT(stack, push, 1); \
+	if (stack->size == stack->capacity) { \
+		p##SetCapacity(stack, 2 * stack->capacity); \
+	} \
+	stack->values[stack->size++] = value; \
+} \
+ \
+/* Pushes k values in order, so values[k - 1] ends up on top, \
+   growing the array at most once. */ \
+scope void p##PushN(struct Tag* stack, const type* values, size_t k) \
+{ \
+	assert(stack != NULL); \
+	assert(values != NULL || k == 0); \
+	if (k == 0) return; \
+	STACK_STAT(stack, pushN, 1); \
+	if (stack->size + k > stack->capacity) { \
+		size_t capacity = stack->capacity; \
+		while (capacity < stack->size + k) { \
+			capacity *= 2; \
+		} \
+		p##SetCapacity(stack, capacity); \
+	} \
+	memcpy(stack->values + stack->size, values, k * sizeof(type)); \
+	stack->size += k; \
+} \
+ \
+/* Halves the array once the stack fills only a quarter of it. */ \
+scope type p##Pop(struct Tag* stack) \
+{ \
+	assert(stack != NULL); \
+	assert(stack->size > 0); \
+	STACK_STAT(stack, pop, 1); \
+	type value = stack->values[--stack->size]; \
+	if (STACK_SHRINKS && stack->capacity / 2 >= stack->floor \
+		&& stack->size <= stack->capacity / 4) { \
+		p##SetCapacity(stack, stack->capacity / 2); \
+	} \
+	return value; \
+} \
+ \
+scope type p##Top(struct Tag* stack) \
+{ \
+	assert(stack != NULL); \
+	assert(stack->size > 0); \
+	STACK_STAT(stack, top, 1); \
+	return stack->values[stack->size - 1]; \
+} \
+ \
+STACK_STATS_GET(Tag, p, scope)
+
+// Writes a whole stack of type named name; see the overview.
+#define STACK_DEFINE(name, type) \
+	STACK_DEFINE_TYPES(name) \
+	STACK_DEFINE_STRUCT(name, type) \
+	STACK_DEFINE_FUNCTIONS(name, name, type, static inline)
+
+#endif
@@ -0,0 +1,90 @@
+/***********************************************************
+* Filename: stackTemplateMain.c
+*
+* Overview:
+*   Tests the stack template (stackTemplate.h) with three element
+*	types in one program: int, double, and a struct. Each stack is
+*	pushed past its first capacity, one value and a batch at a time,
+*	then popped back down through the shrinks.
+*
+* Usage:
+* 	1) make template
+*	2) ./template
+************************************************************/
+#include "stackTemplate.h"
+#include <stdio.h>
+
+struct Job {
+	int priority;
+	int id;
+};
+
+STACK_DEFINE(intStack, int)
+STACK_DEFINE(doubleStack, double)
+STACK_DEFINE(jobStack, struct Job)
+
+#define VALUES 1000
+
+void assertTrue(int pred, char* msg)
+{
+	printf("%s: ", msg);
+	if(pred)
+		printf("\tPASSED\n");
+	else
+		printf("\tFAILED\n");
+}
+
+int main()
+{
+	struct intStack* ints = intStackCreate();
+	struct doubleStack* doubles = doubleStackCreate();
+	struct jobStack* jobs = jobStackCreate();
+	int batch[VALUES / 2];
+
+	assertTrue(intStackIsEmpty(ints) && doubleStackIsEmpty(doubles)
+		&& jobStackIsEmpty(jobs), "New stacks are empty");
+
+	for (int i = 0; i < VALUES / 2; i++) {
+		intStackPush(ints, i);
+		batch[i] = VALUES / 2 + i;
+		doubleStackPush(doubles, i + 0.5);
+		struct Job job = {i % 7, i};
+		jobStackPush(jobs, job);
+	}
+	intStackPushN(ints, batch, VALUES / 2);
+	intStackPushN(ints, batch, 0);
+	assertTrue(intStackSize(ints) == VALUES && intStackTop(ints) == VALUES - 1,
+		"Push and PushN stack ints in order");
+	assertTrue(doubleStackSize(doubles) == VALUES / 2
+		&& doubleStackTop(doubles) == VALUES / 2 - 0.5, "Doubles keep their type");
+	assertTrue(jobStackTop(jobs).id == VALUES / 2 - 1
+		&& jobStackTop(jobs).priority == (VALUES / 2 - 1) % 7, "Structs keep their fields");
+
+	int ordered = 1;
+	for (int i = VALUES - 1; i >= 0; i--) {
+		ordered = ordered && intStackPop(ints) == i;
+	}
+	for (int i = VALUES / 2 - 1; i >= 0; i--) {
+		ordered = ordered && doubleStackPop(doubles) == i + 0.5;
+		struct Job job = jobStackPop(jobs);
+		ordered = ordered && job.id == i && job.priority == i % 7;
+	}
+	assertTrue(ordered, "Pop returns the values last in first out");
+	assertTrue(intStackIsEmpty(ints) && doubleStackIsEmpty(doubles)
+		&& jobStackIsEmpty(jobs), "Stacks are empty after popping everything");
+	assertTrue(ints->capacity == STACK_MIN_CAPACITY, "Popping shrinks the array back down");
+
+	intStackReserve(ints, 4 * VALUES);
+	for (int i = 0; i < 4 * VALUES; i++) {
+		intStackPush(ints, i);
+	}
+	while (!intStackIsEmpty(ints)) {
+		intStackPop(ints);
+	}
+	assertTrue(ints->capacity == 4 * VALUES, "Reserve sets the floor for shrinks");
+
+	intStackDestroy(ints);
+	doubleStackDestroy(doubles);
+	jobStackDestroy(jobs);
+	return 0;
+}
@@ -16,8 +16,11 @@
 *		- getting the value of the front
 *		- removing the front link (dequeue)
 *		- checking if the queue is empty
+*		- moving existing links: detaching the front link,
+*		  appending a link, and splicing a whole queue onto
+*		  the back of another
 *	The stack implementation using the queue ADT " ":
-*		- adding a new link to the front (push - expensive)
+*		- adding a new link to the front (push)
 *		- removing the front link (pop)
 *		- getting the value of the front link (top)
 *		- checking if the stack is empty
@@ -25,15 +28,29 @@
 *	stack involve using the second queue to properly dequeue
 *	the first queue's links when performing a push operation 
 *	and swapping the first and second queues so the first 
-*	always represents the actual 'stack'. This makes this op
-*	expensive, but then top and pop are easy/efficient ops
-*	given that the queue ADT has O(1) access to the front.
+*	always represents the actual 'stack'. Rather than dequeueing
+*	and re-enqueueing q1's values one by one (a free and a malloc
+*	per link), q1 is spliced onto q2 using the queues' head and
+*	tail pointers, so a push only allocates the new link. Top and
+*	pop are easy/efficient ops given that the queue ADT has O(1)
+*	access to the front. listStackPushN pushes a batch of k values
+*	the same way in O(k).
 *
 *	Note that this implementation uses single links, i.e. each
 *	link only has a next pointer. Each queue has a head and tail
 *	pointer that point to first/last link respectively. Each stack
 *	has two queue pointers.
 *
+*	Built with -DCONTAINER_STATS, each stack also counts its
+*	operations, links and live bytes (see listStackGetStats);
+*	otherwise the STAT macro compiles away.
+*
+*	The queue and stack functions are declared in stack_from_queue.h;
+*	compile with -DSTACK_FROM_QUEUE_NO_MAIN to link them into
+*	another program (e.g. the benchmark) without the test main, and
+*	with -DSTACK_FROM_QUEUE_NO_STACK to leave the stack out and link
+*	another stack engine (stackArray.c) with the queue and the main.
+*
 * Usage:
 * 	1) gcc -g Wall -std=c99 -o stack_from_queue stack_from_queue
 *	2) ./stack_from_queue 
@@ -41,9 +58,12 @@
 #include <assert.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include "stack_from_queue.h"
 
-#ifndef TYPE
-#define TYPE int
+#ifdef CONTAINER_STATS
+#define STAT(stack, field, n) ((stack)->stats.field += (n))
+#else
+#define STAT(stack, field, n) ((void)0)
 #endif
 
 // Single link
@@ -58,11 +78,16 @@ struct Queue {
 	struct Link* tail;
 };
 
+#ifndef STACK_FROM_QUEUE_NO_STACK
 // Stack with two Queue instances
 struct Stack {
 	struct Queue* q1;
 	struct Queue* q2;
+#ifdef CONTAINER_STATS
+	struct StackStats stats;
+#endif
 };
+#endif
 
 /**
   	Internal func allocates the queue's sentinel. Sets sentinels' next to null,
@@ -97,6 +122,22 @@ struct Queue* listQueueCreate()
     return queue;
 }
 
+/**
+	Appends an existing link to the back of the queue.
+	param: 	queue 	struct Queue ptr
+	param: 	lnk 	struct Link ptr
+	pre: 	queue and lnk are not null
+	pre:	lnk is not in any queue
+	post: 	lnk is the last link (pointed to by queue tail)
+ */
+void listQueueAddBackLink(struct Queue* queue, struct Link* lnk)
+{
+	assert(queue != NULL && lnk != NULL);
+	lnk->next = NULL;
+	queue->tail->next = lnk;
+	queue->tail = lnk;
+}
+
 /**
 	Adds a new link with the given value to the back of the queue.
 	param: 	queue 	struct Queue ptr
@@ -110,10 +151,8 @@ void listQueueAddBack (struct Queue* queue, TYPE value)
     assert(queue != NULL);
     struct Link * lnk = (struct Link *) malloc(sizeof(struct Link));
     assert(lnk != 0);
-    lnk->next = 0;
     lnk->value = value;
-    queue->tail->next = lnk;
-    queue->tail = lnk;
+    listQueueAddBackLink(queue, lnk);
 }
 
 /**
@@ -131,6 +170,25 @@ TYPE listQueueFront(struct Queue* queue)
    return queue->head->next->value;
 }
 
+/**
+	Detaches the link at the front of the queue without freeing it.
+	param: 	queue 	struct Queue ptr
+	pre:	queue is not null
+	pre:	queue is not empty (i.e., queue's head next pointer is not null)
+	post:	first link is removed from the queue
+	ret:	the removed link; the caller now owns it
+ */
+struct Link* listQueueRemoveFrontLink(struct Queue* queue)
+{
+	assert(queue != NULL);
+	struct Link * lnk = queue->head->next;
+	assert(lnk != NULL);
+	queue->head->next = lnk->next;
+	if(queue->head->next == 0)
+		queue->tail = queue->head;
+	return lnk;
+}
+
 /**
 	Removes the link at the front of the queue and returns the value
 	of the removed link.
@@ -142,16 +200,31 @@ TYPE listQueueFront(struct Queue* queue)
 TYPE listQueueRemoveFront(struct Queue* queue) 
 {
 	TYPE val;
-    struct Link * lnk = queue->head->next;
-    assert(queue->head->next != NULL);
+    struct Link * lnk = listQueueRemoveFrontLink(queue);
     val = lnk->value;
-    queue->head->next = lnk->next;
-    if(queue->head->next == 0)
-        queue->tail = queue->head;
     free (lnk);
     return val;
 }
 
+/**
+	Moves every link of src onto the back of dst in O(1) by
+	relinking dst's tail to src's first link, leaving src empty.
+	param: 	dst 	struct Queue ptr
+	param: 	src 	struct Queue ptr
+	pre: 	dst and src are not null and are different queues
+	post: 	dst holds its old links followed by src's old links
+			src is empty
+ */
+void listQueueSplice(struct Queue* dst, struct Queue* src)
+{
+	assert(dst != NULL && src != NULL && dst != src);
+	if (src->head->next == NULL) return;
+	dst->tail->next = src->head->next;
+	dst->tail = src->tail;
+	src->head->next = NULL;
+	src->tail = src->head;
+}
+
 /**
 	Returns 1 if the queue is empty and 0 otherwise.
 	param:	queue	struct Queue ptr
@@ -169,7 +242,8 @@ int listQueueIsEmpty(struct Queue* queue)
 
 /**
 	Deallocates every link in the queue including the sentinel,
-	and frees the queue itself.
+	and frees the queue itself. The links are freed in one pass from
+	the sentinel along the next pointers, without dequeueing them.
 	param:	queue 	struct Queue ptr
 	pre: 	queue is not null
 	post: 	memory allocated to each link is freed
@@ -180,8 +254,11 @@ void listQueueDestroy(struct Queue* queue)
 {
 
         assert(queue != NULL);
-	while(!listQueueIsEmpty(queue)) {
-		listQueueRemoveFront(queue);
+	struct Link* link = queue->head->next;
+	while(link != NULL) {
+		struct Link* next = link->next;
+		free(link);
+		link = next;
 	}
 	free(queue->head);
 	free(queue);
@@ -189,6 +266,7 @@ void listQueueDestroy(struct Queue* queue)
 
 }
 
+#ifndef STACK_FROM_QUEUE_NO_STACK
 /**
 	Allocates and initializes a stack that is comprised of two 
 	instances of Queue data structures.
@@ -203,9 +281,39 @@ struct Stack* listStackFromQueuesCreate()
 	 struct Stack* stack = (struct Stack *)malloc(sizeof(struct Stack));
 	 stack->q1 = listQueueCreate();
 	 stack->q2 = listQueueCreate();
+#ifdef CONTAINER_STATS
+	 struct StackStats zero = {0};
+	 stack->stats = zero;
+	 stack->stats.bytesLive = sizeof(struct Stack) + 2 * (sizeof(struct Queue) + sizeof(struct Link));
+#endif
 	 return stack;
 }
 
+/**
+	Allocates and initializes a stack (two queues; see
+	listStackFromQueuesCreate).
+	pre: 	none
+	return: stack
+ */
+struct Stack* listStackCreate()
+{
+	return listStackFromQueuesCreate();
+}
+
+/**
+	Does nothing: links are allocated one per pushed value, so there
+	is nothing to allocate ahead. Kept so either stack engine can be
+	linked.
+	param: 	stack 	struct Stack ptr
+	param: 	n 		size_t
+	pre: 	stack is not null
+ */
+void listStackReserve(struct Stack* stack, size_t n)
+{
+	assert(stack != NULL);
+	(void)n;
+}
+
 /**
 	Deallocates every link in both queues contained in the stack,
 	(inc.the sentinel), the queues themselves and the stack itself.
@@ -262,29 +370,58 @@ void listSwapStackQueues(struct Stack* stack)
 
 /**
 	Adds a new link with the given value to the back of the Queue q2.
-	Then while Queue q1 isn't empty, the first link of the queue is 
-	dequeued/removed and added to the back of Queue q2, so that in
-	the end, Queue q2 has the new order to represent the stack properly
-	with the new value at the front of the queue.
+	Then all of Queue q1's links are spliced onto the back of Queue q2
+	(relinked, not copied), so that in the end, Queue q2 has the new
+	order to represent the stack properly with the new value at the
+	front of the queue.
 	param: 	stack 	struct LinkedList ptr
 	param: 	value 	TYPE
 	pre: 	stack is not null
 	post: 	new link is created w/ given value and added to end of q2
-			the first link of q1 is removed and added to end of q2 until
-			it's empty
+			q1's links are moved to the end of q2 (call to listQueueSplice)
 			q1 and q2 are swapped
  */
 void listStackPush(struct Stack* stack, TYPE value) 
 {
 	assert(stack != NULL);
+	STAT(stack, push, 1);
+	STAT(stack, linksAllocated, 1);
+	STAT(stack, bytesLive, (long)sizeof(struct Link));
+	STAT(stack, splices, 1);
     listQueueAddBack(stack->q2, value);
-    while(!listQueueIsEmpty(stack->q1))
-    {
-        listQueueAddBack(stack->q2, listQueueRemoveFront(stack->q1));
-    }
+    listQueueSplice(stack->q2, stack->q1);
     listSwapStackQueues(stack);
 }
 
+/**
+	Pushes k values onto the stack in order, so values[k - 1] ends up
+	on top. The new links are added to q2 top first, then q1's links
+	are spliced behind them and q1 and q2 are swapped, so the queues
+	are rotated once for the whole batch.
+	param: 	stack 	struct Stack ptr
+	param: 	values 	const TYPE ptr
+	param: 	k 		size_t
+	pre: 	stack is not null
+	pre:	values is not null unless k is 0
+	post: 	k new links are on top of the stack, last value first
+			q1 is empty and q1 and q2 are swapped
+ */
+void listStackPushN(struct Stack* stack, const TYPE* values, size_t k)
+{
+	assert(stack != NULL);
+	assert(values != NULL || k == 0);
+	if (k == 0) return;
+	STAT(stack, pushN, 1);
+	STAT(stack, linksAllocated, (long)k);
+	STAT(stack, bytesLive, (long)(k * sizeof(struct Link)));
+	STAT(stack, splices, 1);
+	for (size_t i = k; i > 0; i--) {
+		listQueueAddBack(stack->q2, values[i - 1]);
+	}
+	listQueueSplice(stack->q2, stack->q1);
+	listSwapStackQueues(stack);
+}
+
 /**
 	Removes the link at the top of the stack and returns its value.
 	param: 	stack 	struct Stack ptr
@@ -297,6 +434,9 @@ TYPE listStackPop(struct Stack* stack)
 {
     assert(stack != NULL);
     assert(listQueueIsEmpty(stack->q1) == 0);
+	STAT(stack, pop, 1);
+	STAT(stack, linksFreed, 1);
+	STAT(stack, bytesLive, -(long)sizeof(struct Link));
     return listQueueRemoveFront(stack->q1);
 }
 
@@ -312,9 +452,27 @@ TYPE listStackTop(struct Stack* stack)
 {
     assert(stack != NULL);
     assert(listQueueIsEmpty(stack->q1) == 0);
+	STAT(stack, top, 1);
     return listQueueFront(stack->q1);
 }
 
+#ifdef CONTAINER_STATS
+/**
+	Copies the stack's operation counters into stats.
+	param:	stack	struct Stack ptr
+	param:	stats	struct StackStats ptr
+	pre:	stack and stats are not null
+	post:	stats holds the counts since the stack was created
+ */
+void listStackGetStats(struct Stack* stack, struct StackStats* stats)
+{
+	assert(stack != NULL && stats != NULL);
+	*stats = stack->stats;
+}
+#endif
+#endif
+
+#ifndef STACK_FROM_QUEUE_NO_MAIN
 /**
 	Used for testing the stack from queue implementation.
  */
@@ -330,7 +488,7 @@ void assertTrue(int pred, char* msg)
 
 int main() 
 {
-	struct Stack* s = listStackFromQueuesCreate();
+	struct Stack* s = listStackCreate();
 	assert(s);
 	printf("\n-------------------------------------------------\n"); 
 	printf("---- Testing stack from queue implementation ----\n");
@@ -358,8 +516,30 @@ int main()
 	}
 	assertTrue(listStackTop(s) == 9, "top val == 9\t");
 
+	printf("\npushing 10-14 as a batch...\n");
+	int batch[] = {10, 11, 12, 13, 14};
+	listStackPushN(s, batch, 5);
+	assertTrue(listStackPop(s) == 14, "popping; val == 14");
+	assertTrue(listStackPop(s) == 13, "popping; val == 13");
+	for(int i = 0; i < 3; i++) {
+		listStackPop(s);
+	}
+	assertTrue(listStackTop(s) == 9, "top val == 9\t");
+
+	printf("\nreserving 1000, pushing and popping 0-999...\n");
+	listStackReserve(s, 1000);
+	for(int i = 0; i < 1000; i++) {
+		listStackPush(s, i);
+	}
+	int inOrder = 1;
+	for(int i = 999; i >= 0; i--) {
+		if(listStackPop(s) != i) inOrder = 0;
+	}
+	assertTrue(inOrder, "popped 999-0 in order");
+	assertTrue(listStackTop(s) == 9, "top val == 9\t");
+
 	listStackDestroy(s);
 
 	return 0;
 }
-
+#endif
@@ -0,0 +1,56 @@
+#ifndef STACK_FROM_QUEUE_H
+#define STACK_FROM_QUEUE_H
+
+#include <stddef.h>
+
+#ifndef TYPE
+#define TYPE int
+#endif
+
+struct Link;
+struct Queue;
+struct Stack;
+
+// Queue interface
+
+void listQueueInit(struct Queue* queue);
+struct Queue* listQueueCreate();
+void listQueueDestroy(struct Queue* queue);
+void listQueueAddBack(struct Queue* queue, TYPE value);
+TYPE listQueueFront(struct Queue* queue);
+TYPE listQueueRemoveFront(struct Queue* queue);
+int listQueueIsEmpty(struct Queue* queue);
+void listQueueAddBackLink(struct Queue* queue, struct Link* lnk);
+struct Link* listQueueRemoveFrontLink(struct Queue* queue);
+void listQueueSplice(struct Queue* dst, struct Queue* src);
+
+// Stack interface: stack_from_queue.c (two queues) and stackArray.c
+// (growable array) each implement it; link exactly one of them.
+// listStackCreate makes a stack of whichever engine is linked.
+
+struct Stack* listStackCreate();
+struct Stack* listStackFromQueuesCreate();	// stack_from_queue.c only
+void listStackReserve(struct Stack* stack, size_t n);
+void listStackDestroy(struct Stack* stack);
+int listStackIsEmpty(struct Stack* stack);
+void listStackPush(struct Stack* stack, TYPE value);
+void listStackPushN(struct Stack* stack, const TYPE* values, size_t k);
+TYPE listStackPop(struct Stack* stack);
+TYPE listStackTop(struct Stack* stack);
+
+// Operation counters (only when built with -DCONTAINER_STATS)
+
+#ifdef CONTAINER_STATS
+struct StackStats
+{
+	long push, pushN, pop, top;
+	long linksAllocated;	// value links allocated by push/pushN
+	long linksFreed;		// " " freed by pop
+	long bytesLive;			// bytes currently malloc'd by the stack
+	long splices;			// q1 -> q2 splices (one per push/pushN)
+};
+
+void listStackGetStats(struct Stack* stack, struct StackStats* stats);
+#endif
+
+#endif